@@ -1,9 +1,11 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <execution>
 #include <iterator>
 #include <numeric>
+#include <vector>
 
 namespace bench
 {
@@ -35,6 +37,44 @@ constexpr auto sum_red(Exec&& exec, InputIterator vals_b, InputIterator vals_e,
   return std::reduce(std::forward<Exec>(exec), vals_b, vals_e, init);
 }
 
+// Runs op on Batch::size words at once, the remaining words one by one. op has to accept both, the batches
+// and single words.
+template<class Batch, class Exec, typename T, class Op>
+void batched_transform(Exec&& exec, const T* x_b, const T* x_e, const T* y_b, T* z_b, Op op)
+{
+  const auto batches = static_cast<std::size_t>(x_e - x_b) / Batch::size;
+  const auto rest = static_cast<std::ptrdiff_t>(batches * Batch::size);
+
+  std::vector<std::size_t> indices(batches);
+  std::iota(indices.begin(), indices.end(), std::size_t {0});
+
+  std::for_each(exec,
+                indices.begin(),
+                indices.end(),
+                [=](std::size_t index)
+                {
+                  const auto i = index * Batch::size;
+
+                  op(Batch::load(x_b + i), Batch::load(y_b + i)).store(z_b + i);
+                });
+
+  std::transform(std::forward<Exec>(exec), x_b + rest, x_e, y_b + rest, z_b + rest, op);
+}
+
+template<class Batch, class Exec, typename T>
+void xpy_batched(Exec&& exec, const T* x_b, const T* x_e, const T* y_b, T* z_b)
+{
+  batched_transform<Batch>(
+      std::forward<Exec>(exec), x_b, x_e, y_b, z_b, [](const auto& x, const auto& y) { return x + y; });
+}
+
+template<class Batch, class Exec, typename T>
+void elemwise_max_batched(Exec&& exec, const T* x_b, const T* x_e, const T* y_b, T* z_b)
+{
+  batched_transform<Batch>(
+      std::forward<Exec>(exec), x_b, x_e, y_b, z_b, [](const auto& x, const auto& y) { return max(x, y); });
+}
+
 // Alternative implementation with purely integer based reduction
 template<class Exec, class InputIterator, typename T>
 constexpr auto sum_red_alt(Exec&& exec, InputIterator vals_b, InputIterator vals_e, T init)
@@ -3,6 +3,11 @@
 #include <benchmark/benchmark.h>
 #include <multipleint/mi.hpp>
 
+// The batches and the dispatched kernels need the vector extensions of GCC and Clang
+#if defined(__GNUC__)
+#  include <multipleint/mibatch.hpp>
+#endif
+
 #include "../include/bench_targets.hpp"
 #include "../include/util.hpp"
 
@@ -32,6 +37,22 @@ static void max_red_multi_int_bench(benchmark::State& state)
   }
 }
 
+#if defined(__GNUC__)
+template<class T>
+static void max_red_dispatch_bench(benchmark::State& state)
+{
+  auto xs = multipleint::detail::array_repeat<T::IntCount, int>(1);
+
+  const auto n_elements = state.range(0);
+  const Container<T> vals(n_elements, T::template encode<T::IntCount>(xs));
+  const auto init = std::numeric_limits<T>::lowest();
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(multipleint::max_red(exec_policy, std::span<const T>(vals), init).max());
+  }
+}
+#endif
+
 // needs to be first defined benchmark!
 BENCHMARK_TEMPLATE(max_red_int_bench, std::uint32_t, std::uint32_t, 31)->Name("_warmup_")->Arg(1 << 28);
 
@@ -58,6 +79,13 @@ BENCHMARK_TEMPLATE(max_red_multi_int_bench, multipleint::multiple_int<16, std::u
     ->RangeMultiplier(1 << 2)
     ->Range(1 << 14, 1 << 30);
 
+#if defined(__GNUC__)
+BENCHMARK_TEMPLATE(max_red_dispatch_bench, multipleint::multiple_int<16, std::uint64_t>)
+    ->Name("maxred-1-mi<16, u64>-dispatch")
+    ->RangeMultiplier(1 << 2)
+    ->Range(1 << 14, 1 << 30);
+#endif
+
 //--------------------------------------------------------------------------------------------//
 //--------------------------------------------------------------------------------------------//
 
@@ -71,6 +99,13 @@ BENCHMARK_TEMPLATE(max_red_multi_int_bench, multipleint::multiple_int<7, std::ui
     ->RangeMultiplier(1 << 2)
     ->Range(1 << 14, 1 << 30);
 
+#if defined(__GNUC__)
+BENCHMARK_TEMPLATE(max_red_dispatch_bench, multipleint::multiple_int<7, std::uint64_t>)
+    ->Name("maxred-2-mi<7, u64>-dispatch")
+    ->RangeMultiplier(1 << 2)
+    ->Range(1 << 14, 1 << 30);
+#endif
+
 BENCHMARK_TEMPLATE(max_red_int_bench, std::uint8_t, std::uint64_t, 2)
     ->Name("maxred-2-u8x21")
     ->RangeMultiplier(1 << 2)
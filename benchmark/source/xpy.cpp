@@ -3,6 +3,11 @@
 #include <benchmark/benchmark.h>
 #include <multipleint/mi.hpp>
 
+// The batches and the dispatched kernels need the vector extensions of GCC and Clang
+#if defined(__GNUC__)
+#  include <multipleint/mibatch.hpp>
+#endif
+
 #include "../include/bench_targets.hpp"
 #include "../include/util.hpp"
 
@@ -42,6 +47,47 @@ static void xpy_multi_int_bench(benchmark::State& state)
   }
 }
 
+#if defined(__GNUC__)
+template<std::size_t BitWidth, typename BackingStorage>
+static void xpy_batch_bench(benchmark::State& state)
+{
+  using T = multipleint::multiple_int<BitWidth, BackingStorage>;
+  using batch = multipleint::multiple_int_batch<BitWidth, BackingStorage>;
+
+  auto xs = multipleint::detail::array_repeat<T::IntCount, int>(1);
+  auto ys = multipleint::detail::array_repeat<T::IntCount, int>(2);
+
+  const auto n_elements = state.range(0);
+  const Container<T> x(n_elements, T::template encode<T::IntCount>(xs));
+  Container<T> y(n_elements, T::template encode<T::IntCount>(ys));
+
+  for (auto _ : state) {
+    bench::xpy_batched<batch>(exec_policy, x.data(), x.data() + x.size(), y.data(), y.data());
+
+    benchmark::DoNotOptimize(y);
+  }
+}
+
+template<std::size_t BitWidth, typename BackingStorage>
+static void xpy_dispatch_bench(benchmark::State& state)
+{
+  using T = multipleint::multiple_int<BitWidth, BackingStorage>;
+
+  auto xs = multipleint::detail::array_repeat<T::IntCount, int>(1);
+  auto ys = multipleint::detail::array_repeat<T::IntCount, int>(2);
+
+  const auto n_elements = state.range(0);
+  const Container<T> x(n_elements, T::template encode<T::IntCount>(xs));
+  Container<T> y(n_elements, T::template encode<T::IntCount>(ys));
+
+  for (auto _ : state) {
+    multipleint::xpy(exec_policy, std::span<const T>(x), std::span<const T>(y), std::span<T>(y));
+
+    benchmark::DoNotOptimize(y);
+  }
+}
+#endif
+
 // needs to be first defined benchmark!
 BENCHMARK_TEMPLATE(xpy_int_bench, std::uint32_t, std::uint32_t, 31)->Name("_warmup_")->Arg(1 << 28);
 
@@ -68,6 +114,18 @@ BENCHMARK_TEMPLATE(xpy_multi_int_bench, multipleint::multiple_int<16, std::uint6
     ->RangeMultiplier(1 << 2)
     ->Range(1 << 14, 1 << 30);
 
+#if defined(__GNUC__)
+BENCHMARK_TEMPLATE(xpy_batch_bench, 16, std::uint64_t)
+    ->Name("xpy-1-mi<16, u64>-batch")
+    ->RangeMultiplier(1 << 2)
+    ->Range(1 << 14, 1 << 30);
+
+BENCHMARK_TEMPLATE(xpy_dispatch_bench, 16, std::uint64_t)
+    ->Name("xpy-1-mi<16, u64>-dispatch")
+    ->RangeMultiplier(1 << 2)
+    ->Range(1 << 14, 1 << 30);
+#endif
+
 //--------------------------------------------------------------------------------------------//
 //--------------------------------------------------------------------------------------------//
 
@@ -81,6 +139,18 @@ BENCHMARK_TEMPLATE(xpy_multi_int_bench, multipleint::multiple_int<7, std::uint64
     ->RangeMultiplier(1 << 2)
     ->Range(1 << 14, 1 << 30);
 
+#if defined(__GNUC__)
+BENCHMARK_TEMPLATE(xpy_batch_bench, 7, std::uint64_t)
+    ->Name("xpy-2-mi<7, u64>-batch")
+    ->RangeMultiplier(1 << 2)
+    ->Range(1 << 14, 1 << 30);
+
+BENCHMARK_TEMPLATE(xpy_dispatch_bench, 7, std::uint64_t)
+    ->Name("xpy-2-mi<7, u64>-dispatch")
+    ->RangeMultiplier(1 << 2)
+    ->Range(1 << 14, 1 << 30);
+#endif
+
 BENCHMARK_TEMPLATE(xpy_int_bench, std::uint8_t, std::uint64_t, 1)
     ->Name("xpy-2-u8x32")
     ->RangeMultiplier(1 << 2)
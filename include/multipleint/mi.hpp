@@ -1,8 +1,11 @@
 #pragma once
 
 #include <array>
+#include <bit>
+#include <cstdint>
 #include <type_traits>
 
+#include "miswar.hpp"
 #include "mitraits.hpp"
 #include "miutility.hpp"
 
@@ -13,6 +16,11 @@
 namespace multipleint
 {
 
+namespace detail
+{
+struct _multiple_int_access;
+}  // namespace detail
+
 template<std::size_t BitWidth, std::unsigned_integral BackingStorage>
 class multiple_int
 {
@@ -22,12 +30,16 @@ public:
 
   using traits = detail::_multiple_int_traits<IntCount, BitWidth, BackingStorage>;
 
+  using swar = detail::_swar<BitWidth, BackingStorage>;
+
   friend std::numeric_limits<multiple_int<BitWidth, BackingStorage>>;  // needed for private ctor
 
   // We cannot access the private member in the conversion constructor because we
   // are here in a templated class.
   friend multiple_int<2 * BitWidth + 1, typename traits::template next_widest<BackingStorage>>;
 
+  friend detail::_multiple_int_access;  // needed for private ctor in the array algorithms
+
 private:
   constexpr explicit multiple_int(BackingStorage value)
       : value_ {value}
@@ -186,29 +198,18 @@ public:
   constexpr friend auto max(multiple_int<BitWidth, BackingStorage> lhs, multiple_int<BitWidth, BackingStorage> rhs)
       -> multiple_int<BitWidth, BackingStorage>
   {
-    using value_type = multiple_int<BitWidth, BackingStorage>;
-
-    auto a = -value_type {rhs.intv()};
-    auto diffA = value_type {lhs.intv()} + a;
-    auto b = -value_type {lhs.intv()};
-    auto diffB = value_type {rhs.intv()} + b;
-
-    // Extract the carry bits and shift it to the sign position
-    auto carries_at_signA = (diffA.carry() >> 1);
-    auto carries_at_signB = (diffB.carry() >> 1);
-
-    auto signs = (((diffA.value_ & traits::sign_mask) & ~carries_at_signA)
-                  | ((diffB.value_ & traits::sign_mask) & carries_at_signB))
-        >> (BitWidth - 1);
+    return multiple_int<BitWidth, BackingStorage> {swar::max(lhs.value_, rhs.value_)};
+  }
 
-    // Generate blocks of 0s or 1s depeding on the sign bit
-    auto max_mask = (signs + traits::int_mask) & traits::int_mask;
-    max_mask |= (max_mask & traits::sign_mask) << 1;
+  constexpr friend auto min(multiple_int<BitWidth, BackingStorage> lhs, multiple_int<BitWidth, BackingStorage> rhs)
+      -> multiple_int<BitWidth, BackingStorage>
+  {
+    const auto max_mask = max_select_mask(lhs, rhs);
 
-    // Select the max value with max_mask and store it in result
-    BackingStorage result = ((lhs.value_ & max_mask) | (rhs.value_ & ~max_mask));
+    // Select the value that was not selected by max
+    BackingStorage result = ((rhs.value_ & max_mask) | (lhs.value_ & ~max_mask));
 
-    return value_type {result};
+    return multiple_int<BitWidth, BackingStorage> {result};
   }
 
   // Returns the maximum of all stored values
@@ -296,59 +297,453 @@ public:
 
   constexpr auto operator+(multiple_int<BitWidth, BackingStorage> rhs) const -> multiple_int<BitWidth, BackingStorage>
   {
-    // Use intv instead of the raw value to avoid adding carry bits, which
-    // would "bleed" their overflow into the LSB of the following integer
-    auto lhsi = this->intv();
-    auto rhsi = rhs.intv();
-    auto sumi = static_cast<BackingStorage>(lhsi + rhsi);
+    return multiple_int<BitWidth, BackingStorage> {swar::add(value_, rhs.value_)};
+  }
 
-    auto lhs_signs = lhsi & traits::sign_mask;
-    auto rhs_signs = rhsi & traits::sign_mask;
-    auto sum_signs = sumi & traits::sign_mask;
+  constexpr auto operator-(multiple_int<BitWidth, BackingStorage> rhs) const -> multiple_int<BitWidth, BackingStorage>
+  {
+    return multiple_int<BitWidth, BackingStorage> {swar::subtract(value_, rhs.value_)};
+  }
 
-    auto error = (lhs_signs ^ sum_signs) & (rhs_signs ^ sum_signs);
+  constexpr auto operator-() const -> multiple_int<BitWidth, BackingStorage>
+  {
+    return multiple_int<BitWidth, BackingStorage> {swar::negate(value_)};
+  }
 
-    // zero out carry bits, replace with calculated carry bits
-    sumi &= traits::int_mask;
-    sumi |= (error << 1) | this->carry() | rhs.carry();
+  // Lane-wise division by a compile-time constant, rounding toward zero like the builtin division
+  /* clang-format off */
+  template<std::size_t Divisor>
+  requires(Divisor > 0)
+  constexpr auto divide_by() const -> multiple_int<BitWidth, BackingStorage>
+  /* clang-format on */
+  {
+    const auto negative = negative_lanes();
+    const auto quotients = divide_magnitudes<Divisor>(negate_lanes(this->intv(), negative));
 
-    return multiple_int<BitWidth, BackingStorage> {sumi};
+    return multiple_int<BitWidth, BackingStorage> {static_cast<BackingStorage>(negate_lanes(quotients, negative)
+                                                                               | this->carry())};
   }
 
-  constexpr auto operator-(multiple_int<BitWidth, BackingStorage> rhs) const -> multiple_int<BitWidth, BackingStorage>
+  // Lane-wise remainder of the division by a compile-time constant, takes the sign of the dividend
+  /* clang-format off */
+  template<std::size_t Divisor>
+  requires(Divisor > 0)
+  constexpr auto mod_by() const -> multiple_int<BitWidth, BackingStorage>
+  /* clang-format on */
   {
-    // Carry bit that only occur when attempting to negate the min.
-    auto inv_rhs = -rhs;
-    auto inv_carries = (inv_rhs.carry() - rhs.carry()) & traits::carry_mask;
+    const auto negative = negative_lanes();
+    const auto magnitudes = negate_lanes(this->intv(), negative);
 
-    auto orig_sum = (*this) + inv_rhs;
+    // Every product is at most as large as the magnitude it is subtracted from, so neither the
+    // multiplication nor the subtraction can borrow from or spill into a neighbouring lane
+    const auto products = static_cast<BackingStorage>(divide_magnitudes<Divisor>(magnitudes) * Divisor);
+    const auto remainders = static_cast<BackingStorage>(magnitudes - products);
 
-    // turn off bits that were set due to negation error
-    orig_sum.value_ &= ~inv_carries;
+    return multiple_int<BitWidth, BackingStorage> {static_cast<BackingStorage>(negate_lanes(remainders, negative)
+                                                                               | this->carry())};
+  }
 
-    // turn on if they were set anyway in the original rhs and rhs
-    orig_sum.value_ |= this->carry() | rhs.carry();
+  // Sorts the stored values in ascending order, i.e. the smallest value is stored at index 0
+  constexpr auto sort_lanes() -> void
+  {
+    using detail::merge_exchange_network_v;
 
-    return orig_sum;
+    /* clang-format off */
+    [this]<std::size_t... Idx>(std::index_sequence<Idx...>) constexpr
+    {
+      (this->compare_exchange<merge_exchange_network_v<IntCount>[Idx].distance,
+                              merge_exchange_network_v<IntCount>[Idx].lanes>(), ...);
+    }(std::make_index_sequence<merge_exchange_network_v<IntCount>.size()> {});
+    /* clang-format on */
   }
 
-  constexpr auto operator-() const -> multiple_int<BitWidth, BackingStorage>
+  // Returns the median of all stored values (the upper one of both medians for an even count)
+  constexpr auto median_lane() const -> std::make_signed_t<BackingStorage>
+  {
+    auto sorted = *this;
+    sorted.sort_lanes();
+
+    return sorted.template extract<IntCount / 2>();
+  }
+
+  // Lane j of the result is lane Idx[j] of this, the carry bits move with their values
+  /* clang-format off */
+  template<std::size_t... Idx>
+  requires(sizeof...(Idx) == IntCount && ((Idx < IntCount) && ...))
+  constexpr auto shuffle() const -> multiple_int<BitWidth, BackingStorage>
+  /* clang-format on */
+  {
+    using detail::lane_moves_v;
+
+    // Every distance by which at least one lane is moved costs one mask and one shift
+    /* clang-format off */
+    return [this]<std::size_t... Move>(std::index_sequence<Move...>) constexpr
+    {
+      return multiple_int<BitWidth, BackingStorage> {static_cast<BackingStorage>(
+          (this->move_lanes<static_cast<std::ptrdiff_t>(Move) - (IntCount - 1), lane_moves_v<Idx...>[Move]>() | ...))};
+    }(std::make_index_sequence<2 * static_cast<std::size_t>(IntCount) - 1> {});
+    /* clang-format on */
+  }
+
+  // Rotates the lanes like std::rotate, i.e. lane N becomes lane 0
+  /* clang-format off */
+  template<std::size_t N>
+  requires(N < IntCount)
+  constexpr auto rotate_lanes() const -> multiple_int<BitWidth, BackingStorage>
+  /* clang-format on */
+  {
+    return [this]<std::size_t... Idx>(std::index_sequence<Idx...>) constexpr
+    {
+      return this->shuffle<(Idx + N) % IntCount...>();
+    }(std::make_index_sequence<static_cast<std::size_t>(IntCount)> {});
+  }
+
+  constexpr auto reverse_lanes() const -> multiple_int<BitWidth, BackingStorage>
+  {
+    return [this]<std::size_t... Idx>(std::index_sequence<Idx...>) constexpr
+    {
+      return this->shuffle<(IntCount - 1 - Idx)...>();
+    }(std::make_index_sequence<static_cast<std::size_t>(IntCount)> {});
+  }
+
+  // Copies lane I into all lanes
+  /* clang-format off */
+  template<std::size_t I>
+  requires(I < IntCount)
+  constexpr auto broadcast() const -> multiple_int<BitWidth, BackingStorage>
+  /* clang-format on */
   {
-    constexpr auto add_one_mask = static_cast<BackingStorage>((traits::carry_mask << 1) | 1) & ~traits::empty_mask;
+    using wide_type = std::common_type_t<BackingStorage, unsigned int>;
 
-    BackingStorage tint = this->intv();
-    BackingStorage negated = ~tint;
+    constexpr auto ones = detail::_lane_pattern<IntCount, BitWidth, BackingStorage>(1);
 
-    // apply and twice to avoid carry bits when handling 0
-    BackingStorage un_minus_wcarry = ((negated & traits::int_mask) + add_one_mask);
+    // Multiplying with a 1 in every lane places a copy of the isolated lane in every lane
+    const auto lane = static_cast<wide_type>((value_ >> (I * (BitWidth + 1))) & traits::lane_mask);
 
-    BackingStorage no_sign_change = (~(tint ^ un_minus_wcarry) & traits::sign_mask) << 1;
-    BackingStorage errors = no_sign_change ^ (un_minus_wcarry & traits::carry_mask);
+    return multiple_int<BitWidth, BackingStorage> {static_cast<BackingStorage>(lane * ones)};
+  }
+
+  // Places value in every lane
+  static constexpr auto broadcast(int value) -> multiple_int<BitWidth, BackingStorage>
+  {
+    using wide_type = std::common_type_t<BackingStorage, unsigned int>;
+
+    constexpr auto ones = detail::_lane_pattern<IntCount, BitWidth, BackingStorage>(1);
+    constexpr auto mask = (static_cast<wide_type>(1) << BitWidth) - 1;
+
+    return multiple_int<BitWidth, BackingStorage> {
+        static_cast<BackingStorage>((static_cast<wide_type>(value) & mask) * ones)};
+  }
+
+  // Returns the index of the first stored value equal to value, IntCount if there is none
+  constexpr auto find_lane(int value) const -> int
+  {
+    const auto matches = equal_lanes(value);
 
-    BackingStorage un_minus = un_minus_wcarry & traits::int_mask;
-    BackingStorage with_errors = un_minus | errors | this->carry();
+    if (matches == 0)
+      return IntCount;
 
-    return multiple_int<BitWidth, BackingStorage> {with_errors};
+    return (std::countr_zero(matches) - static_cast<int>(BitWidth)) / static_cast<int>(BitWidth + 1);
+  }
+
+  constexpr auto contains(int value) const -> bool { return equal_lanes(value) != 0; }
+
+  // Returns how many stored values are equal to value
+  constexpr auto count(int value) const -> int { return std::popcount(equal_lanes(value)); }
+
+  // Moves the values selected by the bitmask (bit i selects index i) in their order to the lowest
+  // indices, the remaining indices are cleared. Carry bits move with their values.
+  constexpr auto compact(std::uint64_t selection) const -> multiple_int<BitWidth, BackingStorage>
+  {
+    using wide_type = std::common_type_t<BackingStorage, unsigned int>;
+
+    const auto lanes = static_cast<BackingStorage>(
+        static_cast<wide_type>(detail::expand_lanes<IntCount, BitWidth, BackingStorage>(selection))
+        * traits::lane_mask);
+
+    return multiple_int<BitWidth, BackingStorage> {static_cast<BackingStorage>(detail::compress_bits(value_, lanes))};
+  }
+
+  // Returns a bitmask in which bit i is set iff lo <= (value at index i) <= hi
+  constexpr auto in_range(int lo, int hi) const -> std::uint64_t
+  {
+    constexpr auto min_value = -(static_cast<std::int64_t>(1) << (BitWidth - 1));
+    constexpr auto max_value = (static_cast<std::int64_t>(1) << (BitWidth - 1)) - 1;
+
+    if (lo > hi || lo > max_value || hi < min_value)
+      return 0;
+
+    // The bounds that cannot be exceeded by any value are always fulfilled
+    const auto at_least_lo = (lo <= min_value) ? traits::sign_mask : ~below(lo);
+    const auto at_most_hi = (hi >= max_value) ? traits::sign_mask : below(hi + 1);
+
+    const auto in_range_signs = static_cast<BackingStorage>(at_least_lo & at_most_hi & traits::sign_mask);
+
+    return detail::compress_lanes<IntCount, BitWidth>(static_cast<BackingStorage>(in_range_signs >> (BitWidth - 1)));
+  }
+
+private:
+  // Every value and carry bit of a lane in which lhs is the maximum is set
+  static constexpr auto max_select_mask(multiple_int<BitWidth, BackingStorage> lhs,
+                                        multiple_int<BitWidth, BackingStorage> rhs) -> BackingStorage
+  {
+    return swar::max_select_mask(lhs.value_, rhs.value_);
+  }
+
+  // Orders every lane i in Lanes and the lane i + Distance, the carry bits move with their values
+  template<std::size_t Distance, std::uint64_t Lanes>
+  constexpr auto compare_exchange() -> void
+  {
+    using value_type = multiple_int<BitWidth, BackingStorage>;
+
+    if constexpr (Lanes != 0) {
+      constexpr auto shift = Distance * (BitWidth + 1);
+      constexpr auto lower = detail::_lane_select<IntCount, BitWidth, BackingStorage>(Lanes, traits::lane_mask);
+      constexpr auto upper = static_cast<BackingStorage>(lower << shift);
+
+      const value_type a {static_cast<BackingStorage>(value_ & lower)};
+      const value_type b {static_cast<BackingStorage>((value_ >> shift) & lower)};
+
+      const auto max_mask = max_select_mask(a, b);
+      const auto smaller = (b.value_ & max_mask) | (a.value_ & ~max_mask);
+      const auto larger = (a.value_ & max_mask) | (b.value_ & ~max_mask);
+
+      value_ = static_cast<BackingStorage>((value_ & ~(lower | upper)) | smaller | (larger << shift));
+    }
+  }
+
+  // The sign bit of every lane holding a value less than bound (min < bound <= max) is set
+  constexpr auto below(int bound) const -> BackingStorage
+  {
+    // The difference is negative iff its sign bit differs from its overflow bit. Bound is never the
+    // minimum, so operator- detects every overflow.
+    const auto diff = multiple_int<BitWidth, BackingStorage> {this->intv()} - broadcast(bound);
+
+    return static_cast<BackingStorage>((diff.value_ ^ (diff.carry() >> 1)) & traits::sign_mask);
+  }
+
+  // The carry bit of every lane equal to value is set
+  constexpr auto equal_lanes(int value) const -> BackingStorage
+  {
+    constexpr auto min_value = -(static_cast<std::int64_t>(1) << (BitWidth - 1));
+    constexpr auto max_value = (static_cast<std::int64_t>(1) << (BitWidth - 1)) - 1;
+
+    // broadcast would truncate the value to a lane, so it would match wrapped lanes
+    if (value < min_value || value > max_value)
+      return 0;
+
+    // A lane is zero after the XOR iff it matches. Adding a lane full of 1s carries into the (cleared)
+    // carry bit for every lane that is not zero, and never into the neighbouring lane.
+    const auto diff = static_cast<BackingStorage>(this->intv() ^ broadcast(value).intv());
+
+    return static_cast<BackingStorage>(~(diff + traits::int_mask) & traits::carry_mask);
+  }
+
+  // The lanes selected by Lanes, moved by Distance lanes (towards the upper lanes if positive)
+  template<std::ptrdiff_t Distance, std::uint64_t Lanes>
+  constexpr auto move_lanes() const -> BackingStorage
+  {
+    constexpr auto mask = detail::_lane_select<IntCount, BitWidth, BackingStorage>(Lanes, traits::lane_mask);
+    constexpr auto shift = static_cast<std::size_t>(Distance < 0 ? -Distance : Distance) * (BitWidth + 1);
+
+    if constexpr (Lanes == 0)
+      return 0;
+    else if constexpr (Distance >= 0)
+      return static_cast<BackingStorage>((value_ & mask) << shift);
+    else
+      return static_cast<BackingStorage>((value_ & mask) >> shift);
+  }
+
+  // Every value bit of a lane holding a negative integer is set
+  constexpr auto negative_lanes() const -> BackingStorage
+  {
+    const BackingStorage signs = value_ & traits::sign_mask;
+
+    return static_cast<BackingStorage>((signs << 1) - (signs >> (BitWidth - 1)));
+  }
+
+  // Two's complement of all lanes selected by mask, the other lanes are passed through
+  static constexpr auto negate_lanes(BackingStorage lanes, BackingStorage mask) -> BackingStorage
+  {
+    constexpr auto ones = detail::_lane_pattern<IntCount, BitWidth, BackingStorage>(1);
+
+    // Negating a zero overflows into the carry bit of its own lane, which is cut off again
+    return static_cast<BackingStorage>(((lanes ^ mask) + (mask & ones)) & traits::int_mask);
+  }
+
+  // Lane-wise unsigned division of magnitudes (at most 2^(BitWidth - 1) each) by a compile-time constant
+  template<std::size_t Divisor>
+  static constexpr auto divide_magnitudes(BackingStorage magnitudes) -> BackingStorage
+  {
+    using wide_type = std::common_type_t<BackingStorage, unsigned int>;
+
+    constexpr auto max_magnitude = static_cast<std::uint64_t>(1) << (BitWidth - 1);
+
+    // Masks all bits a quotient can occupy, everything above are remainders of the neighbouring lanes
+    constexpr auto quotient_mask = detail::_lane_pattern<IntCount, BitWidth, BackingStorage>(
+        static_cast<BackingStorage>(std::bit_ceil(max_magnitude / Divisor + 1) - 1));
+
+    if constexpr (Divisor == 1) {
+      return magnitudes;
+    } else if constexpr (Divisor > max_magnitude) {
+      return 0;
+    } else if constexpr (std::has_single_bit(Divisor)) {
+      return static_cast<BackingStorage>((magnitudes >> std::countr_zero(Divisor)) & quotient_mask);
+    } else if constexpr (IntCount == 1) {
+      // There is no room for the widened product, the compiler picks the reciprocal on its own
+      return static_cast<BackingStorage>(magnitudes / Divisor);
+    } else {
+      // Multiply-shift reciprocal (Granlund & Montgomery) which is exact for all numerators < 2^BitWidth:
+      // the products are smaller than 2^(2 * BitWidth + 1)
+      constexpr auto shift = BitWidth + static_cast<std::size_t>(std::bit_width(Divisor - 1));
+      constexpr auto reciprocal =
+          static_cast<wide_type>((static_cast<std::uint64_t>(1) << shift) / Divisor + 1);
+
+      // Every product needs the space of two lanes, so even and odd lanes are divided separately. The
+      // product of the topmost even lane may not fit into the storage, that lane is divided on its own.
+      constexpr auto lane_stride = BitWidth + 1;
+      constexpr auto top_fits = (IntCount % 2 == 0)
+          || ((IntCount - 1) * lane_stride + 2 * BitWidth + 1 <= sizeof(BackingStorage) * CHAR_BIT);
+      constexpr auto top_shift = (IntCount - 1) * lane_stride;
+      constexpr std::size_t spread_count = top_fits ? IntCount : IntCount - 1;
+
+      constexpr auto lane_mask = static_cast<BackingStorage>((static_cast<BackingStorage>(1) << BitWidth) - 1);
+      constexpr auto spread_mask = detail::_lane_pattern<spread_count, BitWidth, BackingStorage>(lane_mask, 0, 2);
+
+      const auto divide = [](BackingStorage spread) constexpr
+      {
+        return static_cast<BackingStorage>((static_cast<wide_type>(spread) * reciprocal) >> shift);
+      };
+
+      BackingStorage quotients = divide(magnitudes & spread_mask) & spread_mask;
+      quotients |= static_cast<BackingStorage>((divide((magnitudes >> lane_stride) & spread_mask) & spread_mask)
+                                               << lane_stride);
+
+      if constexpr (!top_fits)
+        quotients |= static_cast<BackingStorage>(divide(magnitudes >> top_shift) << top_shift);
+
+      return static_cast<BackingStorage>(quotients & quotient_mask);
+    }
   }
 };
+
+namespace detail
+{
+// Raw access to the backing storage for the algorithms working on whole arrays
+struct _multiple_int_access
+{
+  template<class T>
+  using traits = typename T::traits;
+
+  template<std::size_t BitWidth, typename BackingStorage>
+  static constexpr auto value(multiple_int<BitWidth, BackingStorage> mi) -> BackingStorage
+  {
+    return mi.value_;
+  }
+
+  template<class T, typename BackingStorage>
+  static constexpr auto make(BackingStorage value) -> T
+  {
+    return T {value};
+  }
+};
+
+// The multiple_int with 2 * BitWidth + 1 bits and twice the storage, which has as many lanes
+template<std::size_t BitWidth, typename BackingStorage>
+using _widened_multiple_int = multiple_int<2 * BitWidth + 1, typename _next_widest<BackingStorage>::type>;
+}  // namespace detail
+
+// The integers of mi in the multiple_int with 2 * BitWidth + 1 bits and twice the storage, each in the same lane.
+// Unlike the upcasting constructor, which places the even lanes before the odd ones, the result lines up with
+// the words of the wider type for element-wise operations on both. The carry bits are cleared.
+/* clang-format off */
+template<std::size_t BitWidth, typename BackingStorage>
+requires(sizeof(BackingStorage) < sizeof(std::uint64_t))
+constexpr auto widen(multiple_int<BitWidth, BackingStorage> mi)
+    -> detail::_widened_multiple_int<BitWidth, BackingStorage>
+/* clang-format on */
+{
+  return detail::_multiple_int_access::make<detail::_widened_multiple_int<BitWidth, BackingStorage>>(
+      detail::_swar<BitWidth, BackingStorage>::widen(detail::_multiple_int_access::value(mi)));
+}
+
+// Widening within the same storage, like the unpack instructions of SIMD instruction sets: unpack_lo gives the
+// lower half of the lanes of mi, unpack_hi the upper half, each as multiple_int<2 * BitWidth + 1, BackingStorage>
+// with integer k of the half in lane k. This also works for std::uint64_t, which has no wider storage. The
+// carry bits are cleared.
+/* clang-format off */
+template<std::size_t BitWidth, typename BackingStorage>
+requires(multiple_int<BitWidth, BackingStorage>::IntCount % 2 == 0)
+constexpr auto unpack_lo(multiple_int<BitWidth, BackingStorage> mi) -> multiple_int<2 * BitWidth + 1, BackingStorage>
+/* clang-format on */
+{
+  return detail::_multiple_int_access::make<multiple_int<2 * BitWidth + 1, BackingStorage>>(
+      detail::_swar<BitWidth, BackingStorage>::template unpack<0>(detail::_multiple_int_access::value(mi)));
+}
+
+/* clang-format off */
+template<std::size_t BitWidth, typename BackingStorage>
+requires(multiple_int<BitWidth, BackingStorage>::IntCount % 2 == 0)
+constexpr auto unpack_hi(multiple_int<BitWidth, BackingStorage> mi) -> multiple_int<2 * BitWidth + 1, BackingStorage>
+/* clang-format on */
+{
+  return detail::_multiple_int_access::make<multiple_int<2 * BitWidth + 1, BackingStorage>>(
+      detail::_swar<BitWidth, BackingStorage>::template unpack<1>(detail::_multiple_int_access::value(mi)));
+}
+
+// The inverse of unpack_lo and unpack_hi: the integers of lo and hi, truncated to their lowest
+// (BitWidth - 1) / 2 bits like by the downcasting operator, become the lower and the upper half of the lanes
+/* clang-format off */
+template<std::size_t BitWidth, typename BackingStorage>
+requires(BitWidth >= 3 && BitWidth % 2 == 1
+         && multiple_int<BitWidth / 2, BackingStorage>::IntCount
+                == 2 * multiple_int<BitWidth, BackingStorage>::IntCount)
+constexpr auto pack(multiple_int<BitWidth, BackingStorage> lo, multiple_int<BitWidth, BackingStorage> hi)
+    -> multiple_int<BitWidth / 2, BackingStorage>
+/* clang-format on */
+{
+  using access = detail::_multiple_int_access;
+
+  return access::make<multiple_int<BitWidth / 2, BackingStorage>>(
+      detail::_swar<BitWidth / 2, BackingStorage>::pack(access::value(lo), access::value(hi)));
+}
+
+namespace detail
+{
+// Not constexpr, so calling it during constant evaluation fails the compilation
+inline void _packed_array_value_out_of_range() {}
+}  // namespace detail
+
+// The words holding values, laid out like encode_bulk does: values[i] is stored at index i % IntCount of word
+// i / IntCount, unused lanes of a partially filled last word are zero. Evaluated at compile time only, so a
+// constexpr table of packed integers is stored pre-encoded in the read-only data of the binary. A table with a
+// value outside the range of the lanes does not compile.
+template<std::size_t BitWidth, std::unsigned_integral BackingStorage, std::size_t N>
+consteval auto make_packed_array(const std::array<int, N>& values)
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+  constexpr auto min_value = -(static_cast<std::int64_t>(1) << (BitWidth - 1));
+  constexpr auto max_value = (static_cast<std::int64_t>(1) << (BitWidth - 1)) - 1;
+
+  for (const auto value : values) {
+    if (value < min_value || value > max_value)
+      detail::_packed_array_value_out_of_range();
+  }
+
+  std::array<T, (N + int_count - 1) / int_count> result {};
+
+  for (std::size_t w = 0; w < result.size(); ++w) {
+    std::array<int, int_count> lanes {};
+
+    for (std::size_t i = 0; i < int_count && w * int_count + i < N; ++i)
+      lanes[i] = values[w * int_count + i];
+
+    result[w] = T::encode(lanes);
+  }
+
+  return result;
+}
 }  // namespace multipleint
\ No newline at end of file
@@ -0,0 +1,871 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <execution>
+#include <iterator>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "mi.hpp"
+#include "micpu.hpp"
+
+namespace multipleint
+{
+
+namespace detail
+{
+// Writes the integers selected by lane_mask(word index) densely into out and returns their count
+template<class Exec, class RandomAccessIterator, class OutputIterator, class LaneMask>
+auto _copy_lanes(Exec&& exec, RandomAccessIterator b, RandomAccessIterator e, OutputIterator out, LaneMask lane_mask)
+    -> std::size_t
+{
+  using T = typename std::iterator_traits<RandomAccessIterator>::value_type;
+  using access = _multiple_int_access;
+  using storage_type = decltype(access::value(T {}));
+  using traits = typename access::template traits<T>;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+  constexpr auto lane_bits = std::countr_one(traits::lane_mask);
+  constexpr std::size_t chunk_words = 1024;
+
+  // Output words that are shared with a neighbouring chunk are merged afterwards
+  struct partial_word
+  {
+    std::size_t index;
+    storage_type value;
+  };
+
+  struct chunk
+  {
+    std::size_t partial_count;
+    std::array<partial_word, 2> partials;
+  };
+
+  const auto n = static_cast<std::size_t>(std::distance(b, e));
+  std::vector<chunk> chunks((n + chunk_words - 1) / chunk_words);
+  std::vector<std::size_t> offsets(chunks.size() + 1, 0);
+
+  // The algorithms may pass copies of the elements, so the chunks are found by their index
+  std::vector<std::size_t> chunk_indices(chunks.size());
+  std::iota(chunk_indices.begin(), chunk_indices.end(), std::size_t {0});
+
+  // 1. Survivors per chunk
+  std::for_each(exec,
+                chunk_indices.begin(),
+                chunk_indices.end(),
+                [&](std::size_t index)
+                {
+                  const auto first = index * chunk_words;
+                  const auto last = std::min(first + chunk_words, n);
+
+                  std::size_t count = 0;
+
+                  for (auto i = first; i < last; ++i)
+                    count += static_cast<std::size_t>(std::popcount(lane_mask(i)));
+
+                  chunks[index].partial_count = 0;
+                  offsets[index] = count;
+                });
+
+  // 2. Logical output position of every chunk, there are only a few of them
+  std::exclusive_scan(offsets.begin(), offsets.end(), offsets.begin(), std::size_t {0});
+
+  // 3. Compact every chunk into its output range
+  std::for_each(
+      exec,
+      chunk_indices.begin(),
+      chunk_indices.end(),
+      [&](std::size_t index)
+      {
+        auto& c = chunks[index];
+        const auto first = index * chunk_words;
+        const auto last = std::min(first + chunk_words, n);
+        const auto begin = offsets[index];
+        const auto end = offsets[index + 1];
+
+        const auto flush = [&](std::size_t word, storage_type value)
+        {
+          if (word * int_count >= begin && (word + 1) * int_count <= end)
+            out[static_cast<std::ptrdiff_t>(word)] = access::make<T>(value);
+          else
+            c.partials[c.partial_count++] = {word, value};
+        };
+
+        auto position = begin;
+        auto word = position / int_count;
+        storage_type current = 0;
+
+        for (auto i = first; i < last; ++i) {
+          const auto selection = lane_mask(i);
+
+          if (selection == 0)
+            continue;
+
+          const auto kept = access::value(b[static_cast<std::ptrdiff_t>(i)].compact(selection));
+          const auto count = static_cast<std::size_t>(std::popcount(selection));
+          const auto lane = position % int_count;
+
+          current |= static_cast<storage_type>(kept << (lane * lane_bits));
+
+          if (lane + count >= int_count) {
+            flush(word++, static_cast<storage_type>(current & ~traits::empty_mask));
+
+            current = 0;
+
+            // lane > 0 here, so the shift stays below the storage width
+            if (lane + count > int_count)
+              current = static_cast<storage_type>(kept >> ((int_count - lane) * lane_bits));
+          }
+
+          position += count;
+        }
+
+        if (position % int_count != 0)
+          flush(word, current);
+      });
+
+  // 4. Merge the shared output words, the partial words are ordered by their index
+  std::size_t pending_index = 0;
+  storage_type pending_value = 0;
+  bool pending = false;
+
+  for (const auto& c : chunks) {
+    for (std::size_t p = 0; p < c.partial_count; ++p) {
+      if (pending && c.partials[p].index != pending_index)
+        out[static_cast<std::ptrdiff_t>(pending_index)] = access::make<T>(pending_value);
+
+      if (!pending || c.partials[p].index != pending_index)
+        pending_value = 0;
+
+      pending = true;
+      pending_index = c.partials[p].index;
+      pending_value |= c.partials[p].value;
+    }
+  }
+
+  if (pending)
+    out[static_cast<std::ptrdiff_t>(pending_index)] = access::make<T>(pending_value);
+
+  return offsets.back();
+}
+inline constexpr std::size_t _block_size = 4096;
+
+// Calls f(first, count) for consecutive blocks of [0, n), the blocks are processed in parallel
+template<class Exec, class F>
+void _for_each_block(Exec&& exec, std::size_t n, F f)
+{
+  std::vector<std::size_t> blocks((n + _block_size - 1) / _block_size);
+  std::iota(blocks.begin(), blocks.end(), std::size_t {0});
+
+  std::for_each(std::forward<Exec>(exec),
+                blocks.begin(),
+                blocks.end(),
+                [&](std::size_t block)
+                {
+                  const auto first = block * _block_size;
+
+                  f(first, std::min(_block_size, n - first));
+                });
+}
+
+// Reduces init and the results of f(first, count) for consecutive blocks of [0, n) with op, the blocks are
+// processed in parallel
+template<class Exec, typename T, class Op, class F>
+auto _transform_reduce_blocks(Exec&& exec, std::size_t n, T init, Op op, F f) -> T
+{
+  std::vector<std::size_t> blocks((n + _block_size - 1) / _block_size);
+  std::iota(blocks.begin(), blocks.end(), std::size_t {0});
+
+  return std::transform_reduce(std::forward<Exec>(exec),
+                               blocks.begin(),
+                               blocks.end(),
+                               init,
+                               op,
+                               [&](std::size_t block) -> T
+                               {
+                                 const auto first = block * _block_size;
+
+                                 return f(first, std::min(_block_size, n - first));
+                               });
+}
+
+// Every lane of every word is written unconditionally with compile-time shifts, so the loops can be vectorized
+template<std::size_t BitWidth, typename BackingStorage>
+void _encode_words(const std::int32_t* src, multiple_int<BitWidth, BackingStorage>* dst, std::size_t words)
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+  for (std::size_t w = 0; w < words; ++w, src += int_count) {
+    [&dst = dst[w], src]<std::size_t... Idx>(std::index_sequence<Idx...>) constexpr
+    {
+      dst = T {};
+      (dst.template encode<Idx, false>(src[Idx]), ...);
+    }(std::make_index_sequence<int_count> {});
+  }
+}
+
+template<std::size_t BitWidth, typename BackingStorage>
+void _decode_words(const multiple_int<BitWidth, BackingStorage>* src, std::int32_t* dst, std::size_t words)
+{
+  constexpr auto int_count = static_cast<std::size_t>(multiple_int<BitWidth, BackingStorage>::IntCount);
+
+  for (std::size_t w = 0; w < words; ++w, dst += int_count) {
+    [&src = src[w], dst]<std::size_t... Idx>(std::index_sequence<Idx...>) constexpr
+    {
+      ((dst[Idx] = src.template extract<Idx, int>()), ...);
+    }(std::make_index_sequence<int_count> {});
+  }
+}
+
+#if MULTIPLEINT_X86
+// Two int32 are handled at once: pext gathers their low BitWidth bits, all of them are concatenated and a
+// single pdep scatters them into the value bits of the lanes
+template<std::size_t BitWidth, typename BackingStorage>
+__attribute__((target("bmi2"))) void _encode_words_bmi2(const std::int32_t* src,
+                                                        multiple_int<BitWidth, BackingStorage>* dst,
+                                                        std::size_t words)
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+  using access = _multiple_int_access;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+  constexpr std::uint64_t field = (std::uint64_t {1} << BitWidth) - 1;
+  constexpr std::uint64_t pair_fields = field | (field << 32);
+  constexpr std::uint64_t int_mask = access::traits<T>::int_mask;
+
+  for (std::size_t w = 0; w < words; ++w, src += int_count) {
+    std::uint64_t dense = 0;
+
+    for (std::size_t pair = 0; pair < int_count / 2; ++pair) {
+      std::uint64_t values;
+      std::memcpy(&values, src + 2 * pair, sizeof(values));
+
+      dense |= _pext_u64(values, pair_fields) << (2 * BitWidth * pair);
+    }
+
+    if constexpr (int_count % 2 != 0)
+      dense |= (static_cast<std::uint32_t>(src[int_count - 1]) & field) << (BitWidth * (int_count - 1));
+
+    dst[w] = access::make<T>(static_cast<BackingStorage>(_pdep_u64(dense, int_mask)));
+  }
+}
+
+// pext gathers all value bits, pdep then places two values at a time into the low bits of two int32, whose
+// sign bits are then spread upwards
+template<std::size_t BitWidth, typename BackingStorage>
+__attribute__((target("bmi2"))) void _decode_words_bmi2(const multiple_int<BitWidth, BackingStorage>* src,
+                                                        std::int32_t* dst,
+                                                        std::size_t words)
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+  using access = _multiple_int_access;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+  constexpr std::uint64_t field = (std::uint64_t {1} << BitWidth) - 1;
+  constexpr std::uint64_t pair_fields = field | (field << 32);
+  constexpr std::uint64_t pair_ones = std::uint64_t {1} | (std::uint64_t {1} << 32);
+  constexpr std::uint64_t int_mask = access::traits<T>::int_mask;
+
+  for (std::size_t w = 0; w < words; ++w, dst += int_count) {
+    const std::uint64_t dense = _pext_u64(access::value(src[w]), int_mask);
+
+    for (std::size_t pair = 0; pair < int_count / 2; ++pair) {
+      auto values = _pdep_u64(dense >> (2 * BitWidth * pair), pair_fields);
+
+      // (2^(32 - BitWidth) - 1) << BitWidth in every negative int32, no borrows cross the halves
+      const auto negative = (values >> (BitWidth - 1)) & pair_ones;
+      values |= ((negative << (32 - BitWidth)) - negative) << BitWidth;
+
+      std::memcpy(dst + 2 * pair, &values, sizeof(values));
+    }
+
+    if constexpr (int_count % 2 != 0)
+      dst[int_count - 1] = src[w].template extract<int_count - 1, int>();
+  }
+}
+#endif
+
+// Every lane and its carry bit fill exactly one 8, 16 or 32-bit element
+template<std::size_t BitWidth>
+constexpr bool _native_lanes = BitWidth + 1 == 8 || BitWidth + 1 == 16 || BitWidth + 1 == 32;
+
+#if MULTIPLEINT_X86
+template<std::size_t BitWidth>
+using _native_lane_t = std::conditional_t<BitWidth + 1 == 8,
+                                          std::uint8_t,
+                                          std::conditional_t<BitWidth + 1 == 16, std::uint16_t, std::uint32_t>>;
+
+// With native lanes, encoding is narrowing every int32 to an element (without the carry bit) and decoding is
+// sign-extending the elements. Both loops are vectorized by the compiler.
+template<std::size_t BitWidth, typename BackingStorage>
+void _encode_native_lanes(const std::int32_t* src, multiple_int<BitWidth, BackingStorage>* dst, std::size_t words)
+{
+  using element = _native_lane_t<BitWidth>;
+
+  constexpr auto field = static_cast<std::int32_t>((std::uint64_t {1} << BitWidth) - 1);
+
+  auto* out = static_cast<unsigned char*>(static_cast<void*>(dst));
+  const auto n = words * static_cast<std::size_t>(multiple_int<BitWidth, BackingStorage>::IntCount);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto lane = static_cast<element>(src[i] & field);
+    std::memcpy(out + i * sizeof(element), &lane, sizeof(lane));
+  }
+}
+
+template<std::size_t BitWidth, typename BackingStorage>
+void _decode_native_lanes(const multiple_int<BitWidth, BackingStorage>* src, std::int32_t* dst, std::size_t words)
+{
+  using element = _native_lane_t<BitWidth>;
+
+  constexpr auto unused_bits = 32 - BitWidth;
+
+  const auto* in = static_cast<const unsigned char*>(static_cast<const void*>(src));
+  const auto n = words * static_cast<std::size_t>(multiple_int<BitWidth, BackingStorage>::IntCount);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    element lane;
+    std::memcpy(&lane, in + i * sizeof(element), sizeof(lane));
+
+    // Shifting the carry bit out and the sign back in
+    dst[i] = static_cast<std::int32_t>(static_cast<std::uint32_t>(lane) << unused_bits) >> unused_bits;
+  }
+}
+#endif
+
+// The kernels for the dispatch in micpu.hpp. Only native lanes are worth vectorizing, the shifts and masks
+// for the other layouts are not faster in wider registers.
+struct _encode_kernel
+{
+  template<std::size_t RegisterBytes, std::size_t BitWidth, typename BackingStorage>
+  static void run(const std::int32_t* src, multiple_int<BitWidth, BackingStorage>* dst, std::size_t words)
+  {
+#if MULTIPLEINT_X86
+    if constexpr (RegisterBytes != 0 && _native_lanes<BitWidth>) {
+      _encode_native_lanes(src, dst, words);
+      return;
+    }
+#endif
+
+    _encode_words(src, dst, words);
+  }
+};
+
+struct _decode_kernel
+{
+  template<std::size_t RegisterBytes, std::size_t BitWidth, typename BackingStorage>
+  static void run(const multiple_int<BitWidth, BackingStorage>* src, std::int32_t* dst, std::size_t words)
+  {
+#if MULTIPLEINT_X86
+    if constexpr (RegisterBytes != 0 && _native_lanes<BitWidth>) {
+      _decode_native_lanes(src, dst, words);
+      return;
+    }
+#endif
+
+    _decode_words(src, dst, words);
+  }
+};
+
+struct _upcast_kernel
+{
+  template<std::size_t RegisterBytes, class T, class U>
+  static void run(const T* src, U* dst, std::size_t words)
+  {
+    for (std::size_t w = 0; w < words; ++w)
+      dst[w] = U {src[w]};
+  }
+};
+
+struct _downcast_kernel
+{
+  template<std::size_t RegisterBytes, class T, class D>
+  static void run(const T* src, D* dst, std::size_t words)
+  {
+    for (std::size_t w = 0; w < words; ++w)
+      dst[w] = static_cast<D>(src[w]);
+  }
+};
+
+// round(x / scale) + zero_point (ties to even) clamped to the range of the lanes, NaN is taken as 0. The
+// float clamp only keeps the conversion defined, the integer clamp is exact. With a zero_point in the range of
+// lanes of up to 30 bits, everything stays in 32 bits, so the loops are vectorized.
+template<std::size_t BitWidth>
+auto _quantize(float x, float scale, int zero_point) -> std::int32_t
+{
+  constexpr auto min = -(std::int64_t {1} << (BitWidth - 1));
+  constexpr auto max = (std::int64_t {1} << (BitWidth - 1)) - 1;
+
+  const auto q = std::nearbyint(x / scale);
+
+  if constexpr (BitWidth <= 30) {
+    constexpr auto limit = static_cast<float>(1 << 30);
+
+    if (min <= zero_point && zero_point <= max) {
+      const auto clamped = (q != q) ? 0.0f : std::min(std::max(q, -limit), limit);
+
+      return std::clamp(static_cast<std::int32_t>(clamped) + zero_point,
+                        static_cast<std::int32_t>(min),
+                        static_cast<std::int32_t>(max));
+    }
+  }
+
+  constexpr auto limit = static_cast<float>(std::int64_t {1} << 40);
+
+  const auto clamped = (q != q) ? 0.0f : std::min(std::max(q, -limit), limit);
+
+  return static_cast<std::int32_t>(std::clamp(static_cast<std::int64_t>(clamped) + zero_point, min, max));
+}
+
+inline auto _dequantize(std::int32_t q, float scale, int zero_point) -> float
+{
+  return static_cast<float>(static_cast<std::int64_t>(q) - zero_point) * scale;
+}
+
+// The floats of a tile of words are converted in one vectorized loop into a buffer on the stack, which stays in
+// the L1 cache, then the tile is encoded like encode_bulk does
+template<std::size_t BitWidth, typename BackingStorage>
+void _quantize_words(
+    const float* src, multiple_int<BitWidth, BackingStorage>* dst, std::size_t words, float scale, int zero_point)
+{
+  constexpr auto int_count = static_cast<std::size_t>(multiple_int<BitWidth, BackingStorage>::IntCount);
+  constexpr std::size_t tile_words = 64;
+
+  std::array<std::int32_t, tile_words * int_count> tile;
+
+  for (std::size_t w = 0; w < words; w += tile_words) {
+    const auto count = std::min(tile_words, words - w);
+
+    for (std::size_t i = 0; i < count * int_count; ++i)
+      tile[i] = _quantize<BitWidth>(src[w * int_count + i], scale, zero_point);
+
+    _encode_words(tile.data(), dst + w, count);
+  }
+}
+
+template<std::size_t BitWidth, typename BackingStorage>
+void _dequantize_words(
+    const multiple_int<BitWidth, BackingStorage>* src, float* dst, std::size_t words, float scale, int zero_point)
+{
+  constexpr auto int_count = static_cast<std::size_t>(multiple_int<BitWidth, BackingStorage>::IntCount);
+
+  for (std::size_t w = 0; w < words; ++w, dst += int_count) {
+    [&src = src[w], dst, scale, zero_point]<std::size_t... Idx>(std::index_sequence<Idx...>)
+    {
+      ((dst[Idx] = _dequantize(src.template extract<Idx, int>(), scale, zero_point)), ...);
+    }(std::make_index_sequence<int_count> {});
+  }
+}
+
+#if MULTIPLEINT_X86
+// With native lanes, the floats are converted in one vectorized loop over the elements (see _encode_native_lanes)
+template<std::size_t BitWidth, typename BackingStorage>
+void _quantize_native_lanes(
+    const float* src, multiple_int<BitWidth, BackingStorage>* dst, std::size_t words, float scale, int zero_point)
+{
+  using element = _native_lane_t<BitWidth>;
+
+  constexpr auto field = static_cast<std::int32_t>((std::uint64_t {1} << BitWidth) - 1);
+
+  auto* out = static_cast<unsigned char*>(static_cast<void*>(dst));
+  const auto n = words * static_cast<std::size_t>(multiple_int<BitWidth, BackingStorage>::IntCount);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto lane = static_cast<element>(_quantize<BitWidth>(src[i], scale, zero_point) & field);
+    std::memcpy(out + i * sizeof(element), &lane, sizeof(lane));
+  }
+}
+
+template<std::size_t BitWidth, typename BackingStorage>
+void _dequantize_native_lanes(
+    const multiple_int<BitWidth, BackingStorage>* src, float* dst, std::size_t words, float scale, int zero_point)
+{
+  using element = _native_lane_t<BitWidth>;
+
+  constexpr auto unused_bits = 32 - BitWidth;
+
+  const auto* in = static_cast<const unsigned char*>(static_cast<const void*>(src));
+  const auto n = words * static_cast<std::size_t>(multiple_int<BitWidth, BackingStorage>::IntCount);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    element lane;
+    std::memcpy(&lane, in + i * sizeof(element), sizeof(lane));
+
+    const auto q = static_cast<std::int32_t>(static_cast<std::uint32_t>(lane) << unused_bits) >> unused_bits;
+    dst[i] = _dequantize(q, scale, zero_point);
+  }
+}
+#endif
+
+struct _quantize_kernel
+{
+  template<std::size_t RegisterBytes, std::size_t BitWidth, typename BackingStorage>
+  static void run(const float* src,
+                  multiple_int<BitWidth, BackingStorage>* dst,
+                  std::size_t words,
+                  float scale,
+                  int zero_point)
+  {
+#if MULTIPLEINT_X86
+    if constexpr (RegisterBytes != 0 && _native_lanes<BitWidth>) {
+      _quantize_native_lanes(src, dst, words, scale, zero_point);
+      return;
+    }
+#endif
+
+    _quantize_words(src, dst, words, scale, zero_point);
+  }
+};
+
+struct _dequantize_kernel
+{
+  template<std::size_t RegisterBytes, std::size_t BitWidth, typename BackingStorage>
+  static void run(const multiple_int<BitWidth, BackingStorage>* src,
+                  float* dst,
+                  std::size_t words,
+                  float scale,
+                  int zero_point)
+  {
+#if MULTIPLEINT_X86
+    if constexpr (RegisterBytes != 0 && _native_lanes<BitWidth>) {
+      _dequantize_native_lanes(src, dst, words, scale, zero_point);
+      return;
+    }
+#endif
+
+    _dequantize_words(src, dst, words, scale, zero_point);
+  }
+};
+
+// pdep/pext only pay off against the shift chains for many lanes in a wide word. When the build already
+// targets AVX2, the portable kernels are vectorized and at least as fast.
+template<std::size_t BitWidth, typename BackingStorage>
+constexpr bool _use_bmi2_kernels = sizeof(BackingStorage) >= 4 && multiple_int<BitWidth, BackingStorage>::IntCount >= 3;
+
+template<std::size_t BitWidth, typename BackingStorage>
+auto _select_encode_words()
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+  using kernel = void (*)(const std::int32_t*, T*, std::size_t);
+
+  if constexpr (_native_lanes<BitWidth>)
+    return _select_kernel<_encode_kernel, const std::int32_t*, T*, std::size_t>(best_isa());
+
+#if MULTIPLEINT_X86 && !defined(__AVX2__)
+  if constexpr (_use_bmi2_kernels<BitWidth, BackingStorage>) {
+    if (cpu_features().bmi2)
+      return kernel {&_encode_words_bmi2<BitWidth, BackingStorage>};
+  }
+#endif
+
+  return kernel {&_encode_words<BitWidth, BackingStorage>};
+}
+
+template<std::size_t BitWidth, typename BackingStorage>
+auto _select_decode_words()
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+  using kernel = void (*)(const T*, std::int32_t*, std::size_t);
+
+  if constexpr (_native_lanes<BitWidth>)
+    return _select_kernel<_decode_kernel, const T*, std::int32_t*, std::size_t>(best_isa());
+
+#if MULTIPLEINT_X86 && !defined(__AVX2__)
+  if constexpr (_use_bmi2_kernels<BitWidth, BackingStorage>) {
+    if (cpu_features().bmi2)
+      return kernel {&_decode_words_bmi2<BitWidth, BackingStorage>};
+  }
+#endif
+
+  return kernel {&_decode_words<BitWidth, BackingStorage>};
+}
+}  // namespace detail
+
+// Returns the logical index (word index * IntCount + lane index) of the first integer equal to value,
+// std::distance(b, e) * IntCount if there is none. Unused lanes of a partially filled last word are
+// searched as well, so a match at an index past the logical size counts as no match.
+template<class Exec, class InputIterator>
+auto find_first(Exec&& exec, InputIterator b, InputIterator e, int value) -> std::size_t
+{
+  using T = typename std::iterator_traits<InputIterator>::value_type;
+
+  const auto word = std::find_if(std::forward<Exec>(exec), b, e, [value](const T& x) { return x.contains(value); });
+
+  const auto words = static_cast<std::size_t>(std::distance(b, word));
+
+  if (word == e)
+    return words * T::IntCount;
+
+  return words * T::IntCount + static_cast<std::size_t>(word->find_lane(value));
+}
+
+// Returns how many integers are equal to value. Unused lanes of a partially filled last word are
+// counted as well.
+template<class Exec, class InputIterator>
+auto count_equal(Exec&& exec, InputIterator b, InputIterator e, int value) -> std::size_t
+{
+  using T = typename std::iterator_traits<InputIterator>::value_type;
+
+  return std::transform_reduce(std::forward<Exec>(exec),
+                               b,
+                               e,
+                               std::size_t {0},
+                               std::plus<std::size_t>(),
+                               [value](const T& x) -> std::size_t { return static_cast<std::size_t>(x.count(value)); });
+}
+
+// Evaluates lo <= x <= hi for every integer and writes the results as a bitmap: bit j of out_bitmap[k]
+// belongs to the integer with the logical index 64 * k + j. out_bitmap needs room for at least
+// ceil(std::distance(b, e) * IntCount / 64) words.
+template<class Exec, class RandomAccessIterator>
+void range_scan(
+    Exec&& exec, RandomAccessIterator b, RandomAccessIterator e, int lo, int hi, std::span<std::uint64_t> out_bitmap)
+{
+  using T = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+  constexpr std::size_t bitmap_bits = 64;
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+  const auto n = static_cast<std::size_t>(std::distance(b, e));
+  const auto bitmap_words = (n * int_count + bitmap_bits - 1) / bitmap_bits;
+
+  std::vector<std::size_t> indices(bitmap_words);
+  std::iota(indices.begin(), indices.end(), std::size_t {0});
+
+  // Every bitmap word is assembled from all multiple_ints overlapping it, so no two threads ever write
+  // into the same bitmap word
+  std::for_each(std::forward<Exec>(exec),
+                indices.begin(),
+                indices.end(),
+                [&](std::size_t index)
+                {
+                  const auto first = index * bitmap_bits;
+
+                  std::uint64_t bits = 0;
+
+                  for (auto word = first / int_count; word < n && word * int_count < first + bitmap_bits; ++word) {
+                    const auto mask = b[static_cast<std::ptrdiff_t>(word)].in_range(lo, hi);
+                    const auto position = word * int_count;
+
+                    bits |= (position < first) ? (mask >> (first - position)) : (mask << (position - first));
+                  }
+
+                  out_bitmap[index] = bits;
+                });
+}
+
+// Writes the integers for which pred (called with a whole multiple_int, returning a bitmask like
+// in_range) has set their bit densely into out and returns their count. Unused lanes of the last written
+// word are cleared, out needs room for as many words as the input in the worst case.
+template<class Exec, class RandomAccessIterator, class OutputIterator, class Predicate>
+auto compact_if(Exec&& exec, RandomAccessIterator b, RandomAccessIterator e, OutputIterator out, Predicate pred)
+    -> std::size_t
+{
+  return detail::_copy_lanes(
+      std::forward<Exec>(exec), b, e, out, [b, pred](std::size_t i) -> std::uint64_t
+      { return pred(b[static_cast<std::ptrdiff_t>(i)]); });
+}
+
+// Same as compact_if, but the integers are selected by a bitmap as produced by range_scan
+template<class Exec, class RandomAccessIterator, class OutputIterator>
+auto compact(Exec&& exec,
+             RandomAccessIterator b,
+             RandomAccessIterator e,
+             std::span<const std::uint64_t> pred_mask,
+             OutputIterator out) -> std::size_t
+{
+  using T = typename std::iterator_traits<RandomAccessIterator>::value_type;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+  constexpr auto mask = (std::uint64_t {1} << int_count) - 1;
+
+  return detail::_copy_lanes(std::forward<Exec>(exec),
+                             b,
+                             e,
+                             out,
+                             [pred_mask](std::size_t i) -> std::uint64_t
+                             {
+                               const auto first = i * int_count;
+                               const auto word = first / 64;
+                               const auto bit = first % 64;
+
+                               auto bits = pred_mask[word] >> bit;
+
+                               // The bits of a multiple_int may continue in the next bitmap word
+                               if (bit + int_count > 64)
+                                 bits |= pred_mask[word + 1] << (64 - bit);
+
+                               return bits & mask;
+                             });
+}
+
+// Packs the integers of in into out, in[i] is stored at index i % IntCount of out[i / IntCount]. out needs
+// room for at least ceil(in.size() / IntCount) words, unused lanes of a partially filled last word are
+// cleared and words past it are left untouched.
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+void encode_bulk(Exec&& exec,
+                 std::span<const std::int32_t> in,
+                 std::span<multiple_int<BitWidth, BackingStorage>> out)
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+  const auto full_words = in.size() / int_count;
+  const auto tail = in.size() % int_count;
+
+  static const auto kernel = detail::_select_encode_words<BitWidth, BackingStorage>();
+
+  detail::_for_each_block(std::forward<Exec>(exec),
+                          full_words,
+                          [&](std::size_t first, std::size_t count)
+                          { kernel(in.data() + first * int_count, out.data() + first, count); });
+
+  if (tail != 0) {
+    std::array<int, int_count> last {};
+    std::copy_n(in.data() + full_words * int_count, tail, last.begin());
+
+    out[full_words] = T::encode(last);
+  }
+}
+
+// Unpacks the first out.size() integers of in into out, the inverse of encode_bulk. in needs to hold at
+// least ceil(out.size() / IntCount) words.
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+void decode_bulk(Exec&& exec,
+                 std::span<const multiple_int<BitWidth, BackingStorage>> in,
+                 std::span<std::int32_t> out)
+{
+  constexpr auto int_count = static_cast<std::size_t>(multiple_int<BitWidth, BackingStorage>::IntCount);
+
+  const auto full_words = out.size() / int_count;
+  const auto tail = out.size() % int_count;
+
+  static const auto kernel = detail::_select_decode_words<BitWidth, BackingStorage>();
+
+  detail::_for_each_block(std::forward<Exec>(exec),
+                          full_words,
+                          [&](std::size_t first, std::size_t count)
+                          { kernel(in.data() + first, out.data() + first * int_count, count); });
+
+  if (tail != 0) {
+    const auto last = in[full_words].template decode<int_count>();
+
+    std::copy_n(last.begin(), tail, out.data() + full_words * int_count);
+  }
+}
+
+// Quantizes the floats of in into out, stored like encode_bulk: in[i] becomes round(in[i] / scale) + zero_point
+// (ties to even) clamped to numeric_limits<multiple_int>::min/max of the lanes, NaN is taken as 0. The lanes
+// hold ints, so BitWidth is at most 32. On x86, lanes filling 8, 16 or 32-bit elements are converted right into
+// the words, all others go through a stack buffer of the ints of 64 words, which stays in the L1 cache.
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+requires(BitWidth <= 32)
+void quantize(Exec&& exec,
+              std::span<const float> in,
+              float scale,
+              int zero_point,
+              std::span<multiple_int<BitWidth, BackingStorage>> out)
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+  const auto full_words = in.size() / int_count;
+  const auto tail = in.size() % int_count;
+
+  static const auto kernel =
+      detail::_dispatched_kernel<detail::_quantize_kernel, const float*, T*, std::size_t, float, int>();
+
+  detail::_for_each_block(std::forward<Exec>(exec),
+                          full_words,
+                          [&](std::size_t first, std::size_t count)
+                          { kernel(in.data() + first * int_count, out.data() + first, count, scale, zero_point); });
+
+  if (tail != 0) {
+    std::array<int, int_count> last {};
+
+    for (std::size_t i = 0; i < tail; ++i)
+      last[i] = detail::_quantize<BitWidth>(in[full_words * int_count + i], scale, zero_point);
+
+    out[full_words] = T::encode(last);
+  }
+}
+
+// The inverse of quantize for the first out.size() integers of in: out[i] = (integer i - zero_point) * scale
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+requires(BitWidth <= 32)
+void dequantize(Exec&& exec,
+                std::span<const multiple_int<BitWidth, BackingStorage>> in,
+                float scale,
+                int zero_point,
+                std::span<float> out)
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+  const auto full_words = out.size() / int_count;
+  const auto tail = out.size() % int_count;
+
+  static const auto kernel =
+      detail::_dispatched_kernel<detail::_dequantize_kernel, const T*, float*, std::size_t, float, int>();
+
+  detail::_for_each_block(std::forward<Exec>(exec),
+                          full_words,
+                          [&](std::size_t first, std::size_t count)
+                          { kernel(in.data() + first, out.data() + first * int_count, count, scale, zero_point); });
+
+  if (tail != 0) {
+    const auto last = in[full_words].template decode<int_count>();
+
+    for (std::size_t i = 0; i < tail; ++i)
+      out[full_words * int_count + i] = detail::_dequantize(last[i], scale, zero_point);
+  }
+}
+
+// Upcasts every word of in into out (see the upcasting constructor), out needs room for in.size() words
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+void upcast(Exec&& exec,
+            std::span<const multiple_int<BitWidth, BackingStorage>> in,
+            std::span<multiple_int<2 * BitWidth + 1, typename detail::_next_widest<BackingStorage>::type>> out)
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+  using U = multiple_int<2 * BitWidth + 1, typename detail::_next_widest<BackingStorage>::type>;
+
+  static const auto kernel = detail::_dispatched_kernel<detail::_upcast_kernel, const T*, U*, std::size_t>();
+
+  detail::_for_each_block(std::forward<Exec>(exec),
+                          in.size(),
+                          [&](std::size_t first, std::size_t count)
+                          { kernel(in.data() + first, out.data() + first, count); });
+}
+
+// Downcasts every word of in into out (see the downcasting operator), out needs room for in.size() words
+template<class Exec, std::size_t SmallerBitWidth, typename SmallerBackingStorage>
+void downcast(
+    Exec&& exec,
+    std::span<const multiple_int<2 * SmallerBitWidth + 1, typename detail::_next_widest<SmallerBackingStorage>::type>>
+        in,
+    std::span<multiple_int<SmallerBitWidth, SmallerBackingStorage>> out)
+{
+  using T = multiple_int<2 * SmallerBitWidth + 1, typename detail::_next_widest<SmallerBackingStorage>::type>;
+  using D = multiple_int<SmallerBitWidth, SmallerBackingStorage>;
+
+  static const auto kernel = detail::_dispatched_kernel<detail::_downcast_kernel, const T*, D*, std::size_t>();
+
+  detail::_for_each_block(std::forward<Exec>(exec),
+                          in.size(),
+                          [&](std::size_t first, std::size_t count)
+                          { kernel(in.data() + first, out.data() + first, count); });
+}
+
+}  // namespace multipleint
\ No newline at end of file
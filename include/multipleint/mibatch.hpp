@@ -0,0 +1,556 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <span>
+
+#include "mi.hpp"
+#include "mialgorithm.hpp"
+#include "micpu.hpp"
+#include "milimits.hpp"
+
+#if !defined(__GNUC__)
+#  error "multiple_int_batch needs the vector extensions of GCC or Clang"
+#endif
+
+namespace multipleint
+{
+
+// Number of words that fill one SIMD register of the instruction set the code is compiled for. Batches that
+// are wider than a register are split by the compiler and usually slower than the scalar code.
+template<typename BackingStorage>
+inline constexpr std::size_t native_batch_size =
+#if defined(__AVX512F__)
+    64 / sizeof(BackingStorage);
+#elif defined(__AVX__)
+    32 / sizeof(BackingStorage);
+#else
+    16 / sizeof(BackingStorage);
+#endif
+
+// WordCount multiple_ints in a SIMD vector (split into several registers by the compiler if the target has no
+// registers of WordCount * sizeof(BackingStorage) bytes). Every operation runs on all words at once and has
+// exactly the semantics of the operation on a single multiple_int, including the carry bits.
+/* clang-format off */
+template<std::size_t BitWidth,
+         std::unsigned_integral BackingStorage,
+         std::size_t WordCount = native_batch_size<BackingStorage>>
+requires(std::has_single_bit(WordCount))
+class multiple_int_batch
+/* clang-format on */
+{
+public:
+  using value_type = multiple_int<BitWidth, BackingStorage>;
+
+  static constexpr std::size_t size = WordCount;
+
+private:
+  using swar = detail::_swar<BitWidth, BackingStorage>;
+  using access = detail::_multiple_int_access;
+
+  using vector_type = detail::_word_vector<BackingStorage, WordCount>;
+
+  static_assert(sizeof(value_type) == sizeof(BackingStorage), "multiple_int has to be a plain BackingStorage");
+
+  explicit multiple_int_batch(const vector_type& words)
+      : words_ {words}
+  {
+  }
+
+  vector_type words_ {};
+
+  /* clang-format off */
+  template<std::size_t OtherBitWidth, std::unsigned_integral OtherBackingStorage, std::size_t OtherWordCount>
+  requires(std::has_single_bit(OtherWordCount))
+  friend class multiple_int_batch;
+  /* clang-format on */
+
+public:
+  // Default ctor = all zeros
+  multiple_int_batch() = default;
+
+  // Every word is set to value
+  explicit multiple_int_batch(value_type value)
+      : words_ {}
+  {
+    words_.elements += access::value(value);
+  }
+
+  // Every word of narrow widened like widen(multiple_int), so lane k of a word stays lane k
+  /* clang-format off */
+  template<std::size_t SmallerBitWidth, typename SmallerBackingStorage>
+  requires(2 * SmallerBitWidth + 1 == BitWidth && 2 * sizeof(SmallerBackingStorage) == sizeof(BackingStorage))
+  explicit multiple_int_batch(const multiple_int_batch<SmallerBitWidth, SmallerBackingStorage, WordCount>& narrow)
+      : words_ {detail::_swar<SmallerBitWidth, SmallerBackingStorage>::widen(narrow.words_)}
+  /* clang-format on */
+  {
+  }
+
+  // Loads WordCount consecutive words, words does not need to be aligned
+  static auto load(const value_type* words) -> multiple_int_batch
+  {
+    vector_type result;
+    std::memcpy(&result, words, sizeof(result));
+
+    return multiple_int_batch {result};
+  }
+
+  // Stores the words to WordCount consecutive words, words does not need to be aligned
+  auto store(value_type* words) const -> void { std::memcpy(static_cast<void*>(words), &words_, sizeof(words_)); }
+
+  auto operator[](std::size_t index) const -> value_type
+  {
+    return access::make<value_type>(static_cast<BackingStorage>(words_.elements[index]));
+  }
+
+  auto operator+(const multiple_int_batch& rhs) const -> multiple_int_batch
+  {
+    return multiple_int_batch {swar::add(words_, rhs.words_)};
+  }
+
+  auto operator-(const multiple_int_batch& rhs) const -> multiple_int_batch
+  {
+    return multiple_int_batch {swar::subtract(words_, rhs.words_)};
+  }
+
+  auto operator-() const -> multiple_int_batch { return multiple_int_batch {swar::negate(words_)}; }
+
+  friend auto max(const multiple_int_batch& lhs, const multiple_int_batch& rhs) -> multiple_int_batch
+  {
+    return multiple_int_batch {swar::max(lhs.words_, rhs.words_)};
+  }
+
+  // unpack_lo, unpack_hi and pack of every word (see the ones on single words)
+
+  /* clang-format off */
+  friend auto unpack_lo(const multiple_int_batch& batch)
+      -> multiple_int_batch<2 * BitWidth + 1, BackingStorage, WordCount>
+  requires(value_type::IntCount % 2 == 0)
+  /* clang-format on */
+  {
+    return multiple_int_batch<2 * BitWidth + 1, BackingStorage, WordCount> {swar::template unpack<0>(batch.words_)};
+  }
+
+  /* clang-format off */
+  friend auto unpack_hi(const multiple_int_batch& batch)
+      -> multiple_int_batch<2 * BitWidth + 1, BackingStorage, WordCount>
+  requires(value_type::IntCount % 2 == 0)
+  /* clang-format on */
+  {
+    return multiple_int_batch<2 * BitWidth + 1, BackingStorage, WordCount> {swar::template unpack<1>(batch.words_)};
+  }
+
+  /* clang-format off */
+  friend auto pack(const multiple_int_batch& lo, const multiple_int_batch& hi)
+      -> multiple_int_batch<BitWidth / 2, BackingStorage, WordCount>
+  requires(BitWidth >= 3 && BitWidth % 2 == 1
+           && multiple_int<BitWidth / 2, BackingStorage>::IntCount == 2 * value_type::IntCount)
+  /* clang-format on */
+  {
+    return multiple_int_batch<BitWidth / 2, BackingStorage, WordCount> {
+        detail::_swar<BitWidth / 2, BackingStorage>::pack(lo.words_, hi.words_)};
+  }
+};
+
+namespace detail
+{
+
+struct _plus
+{
+  template<class T>
+  auto operator()(const T& lhs, const T& rhs) const -> T
+  {
+    return lhs + rhs;
+  }
+};
+
+struct _maximum
+{
+  template<class T>
+  auto operator()(const T& lhs, const T& rhs) const -> T
+  {
+    return max(lhs, rhs);
+  }
+};
+
+// Kernels for the dispatch in micpu.hpp, which use a batch per register and single words for the rest
+
+template<class Op>
+struct _batch_transform_kernel
+{
+  template<std::size_t RegisterBytes, std::size_t BitWidth, typename BackingStorage>
+  static void run(const multiple_int<BitWidth, BackingStorage>* x,
+                  const multiple_int<BitWidth, BackingStorage>* y,
+                  multiple_int<BitWidth, BackingStorage>* z,
+                  std::size_t words)
+  {
+    std::size_t w = 0;
+
+    if constexpr (RegisterBytes != 0) {
+      using batch = multiple_int_batch<BitWidth, BackingStorage, RegisterBytes / sizeof(BackingStorage)>;
+
+      for (; w + batch::size <= words; w += batch::size)
+        Op {}(batch::load(x + w), batch::load(y + w)).store(z + w);
+    }
+
+    for (; w < words; ++w)
+      z[w] = Op {}(x[w], y[w]);
+  }
+};
+
+// z[i] = Op(widen(x[i]), y[i]), a batch of x fills half a register
+template<class Op>
+struct _widening_transform_kernel
+{
+  template<std::size_t RegisterBytes,
+           std::size_t BitWidth,
+           typename BackingStorage,
+           std::size_t WideBitWidth,
+           typename WideBackingStorage>
+  static void run(const multiple_int<BitWidth, BackingStorage>* x,
+                  const multiple_int<WideBitWidth, WideBackingStorage>* y,
+                  multiple_int<WideBitWidth, WideBackingStorage>* z,
+                  std::size_t words)
+  {
+    std::size_t w = 0;
+
+    if constexpr (RegisterBytes != 0) {
+      using batch = multiple_int_batch<WideBitWidth, WideBackingStorage, RegisterBytes / sizeof(WideBackingStorage)>;
+      using narrow_batch = multiple_int_batch<BitWidth, BackingStorage, batch::size>;
+
+      for (; w + batch::size <= words; w += batch::size)
+        Op {}(batch {narrow_batch::load(x + w)}, batch::load(y + w)).store(z + w);
+    }
+
+    for (; w < words; ++w)
+      z[w] = Op {}(widen(x[w]), y[w]);
+  }
+};
+
+// dst[i] = src[i] narrowed (see narrow), the number of integers that do not fit is added to *offending. If
+// bitmap is not null, their bits are set in it (bit 0 is the first lane of src[0]). Every group of words is
+// checked at once first, the loops are vectorized then, only groups with offending integers are revisited.
+template<bool Saturate>
+struct _narrow_kernel
+{
+  template<std::size_t RegisterBytes,
+           std::size_t WideBitWidth,
+           typename WideBackingStorage,
+           std::size_t BitWidth,
+           typename BackingStorage>
+  static void run(const multiple_int<WideBitWidth, WideBackingStorage>* src,
+                  multiple_int<BitWidth, BackingStorage>* dst,
+                  std::size_t words,
+                  std::uint64_t* bitmap,
+                  std::size_t* offending)
+  {
+    using T = multiple_int<BitWidth, BackingStorage>;
+    using swar = _swar<BitWidth, BackingStorage>;
+    using access = _multiple_int_access;
+
+    constexpr std::size_t group = 64;
+    constexpr std::size_t bitmap_bits = 64;
+    constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+    std::size_t count = 0;
+
+    for (std::size_t first = 0; first < words; first += group) {
+      const auto last = std::min(first + group, words);
+
+      WideBackingStorage any = 0;
+
+      for (auto w = first; w < last; ++w)
+        any |= swar::out_of_range(access::value(src[w]));
+
+      if (any == 0) {
+        for (auto w = first; w < last; ++w)
+          dst[w] = access::make<T>(swar::narrow(access::value(src[w])));
+
+        continue;
+      }
+
+      for (auto w = first; w < last; ++w) {
+        auto value = access::value(src[w]);
+        const auto lanes = swar::out_of_range(value);
+
+        if (lanes != 0) {
+          count += static_cast<std::size_t>(std::popcount(lanes));
+
+          if (bitmap != nullptr) {
+            const auto selected = compress_lanes<int_count, WideBitWidth>(lanes);
+            const auto position = w * int_count;
+            const auto bit = position % bitmap_bits;
+
+            bitmap[position / bitmap_bits] |= selected << bit;
+
+            // The lanes of a word may continue in the next bitmap word
+            if (bit + int_count > bitmap_bits)
+              bitmap[position / bitmap_bits + 1] |= selected >> (bitmap_bits - bit);
+          }
+
+          if constexpr (Saturate)
+            value = swar::saturate(value, lanes);
+        }
+
+        dst[w] = access::make<T>(swar::narrow(value));
+      }
+    }
+
+    *offending += count;
+  }
+};
+
+// Reduces the words into *result
+template<class Op>
+struct _batch_reduce_kernel
+{
+  template<std::size_t RegisterBytes, std::size_t BitWidth, typename BackingStorage>
+  static void run(const multiple_int<BitWidth, BackingStorage>* x,
+                  std::size_t words,
+                  multiple_int<BitWidth, BackingStorage>* result)
+  {
+    std::size_t w = 0;
+    auto value = *result;
+
+    if constexpr (RegisterBytes != 0) {
+      using batch = multiple_int_batch<BitWidth, BackingStorage, RegisterBytes / sizeof(BackingStorage)>;
+
+      if (words >= batch::size) {
+        auto partial = batch::load(x);
+
+        for (w = batch::size; w + batch::size <= words; w += batch::size)
+          partial = Op {}(partial, batch::load(x + w));
+
+        for (std::size_t i = 0; i < batch::size; ++i)
+          value = Op {}(value, partial[i]);
+      }
+    }
+
+    for (; w < words; ++w)
+      value = Op {}(value, x[w]);
+
+    *result = value;
+  }
+};
+
+template<class Op, class Exec, std::size_t BitWidth, typename BackingStorage>
+void _batch_transform(Exec&& exec,
+                      std::span<const multiple_int<BitWidth, BackingStorage>> x,
+                      std::span<const multiple_int<BitWidth, BackingStorage>> y,
+                      std::span<multiple_int<BitWidth, BackingStorage>> z)
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+
+  static const auto kernel = _dispatched_kernel<_batch_transform_kernel<Op>, const T*, const T*, T*, std::size_t>();
+
+  _for_each_block(std::forward<Exec>(exec),
+                  x.size(),
+                  [&](std::size_t first, std::size_t count)
+                  { kernel(x.data() + first, y.data() + first, z.data() + first, count); });
+}
+
+template<class Op, class Exec, std::size_t BitWidth, typename BackingStorage, class Wide>
+void _widening_transform(Exec&& exec,
+                         std::span<const multiple_int<BitWidth, BackingStorage>> x,
+                         std::span<const Wide> y,
+                         std::span<Wide> z)
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+
+  static const auto kernel =
+      _dispatched_kernel<_widening_transform_kernel<Op>, const T*, const Wide*, Wide*, std::size_t>();
+
+  _for_each_block(std::forward<Exec>(exec),
+                  x.size(),
+                  [&](std::size_t first, std::size_t count)
+                  { kernel(x.data() + first, y.data() + first, z.data() + first, count); });
+}
+
+// bitmap may be null
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+auto _narrow(Exec&& exec,
+             std::span<const _widened_multiple_int<BitWidth, BackingStorage>> in,
+             std::span<multiple_int<BitWidth, BackingStorage>> out,
+             std::uint64_t* bitmap,
+             bool saturate) -> std::size_t
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+  using U = _widened_multiple_int<BitWidth, BackingStorage>;
+
+  constexpr std::size_t bitmap_bits = 64;
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+  using kernel_type = void (*)(const U*, T*, std::size_t, std::uint64_t*, std::size_t*);
+
+  static const kernel_type truncating =
+      _dispatched_kernel<_narrow_kernel<false>, const U*, T*, std::size_t, std::uint64_t*, std::size_t*>();
+  static const kernel_type saturating =
+      _dispatched_kernel<_narrow_kernel<true>, const U*, T*, std::size_t, std::uint64_t*, std::size_t*>();
+
+  const auto kernel = saturate ? saturating : truncating;
+
+  // A block covers whole bitmap words, as _block_size is a multiple of 64
+  return _transform_reduce_blocks(
+      std::forward<Exec>(exec),
+      in.size(),
+      std::size_t {0},
+      std::plus<> {},
+      [&](std::size_t first, std::size_t count) -> std::size_t
+      {
+        std::uint64_t* block_bitmap = nullptr;
+
+        if (bitmap != nullptr) {
+          block_bitmap = bitmap + first * int_count / bitmap_bits;
+          std::fill_n(block_bitmap, (count * int_count + bitmap_bits - 1) / bitmap_bits, std::uint64_t {0});
+        }
+
+        std::size_t offending = 0;
+        kernel(in.data() + first, out.data() + first, count, block_bitmap, &offending);
+
+        return offending;
+      });
+}
+
+// identity is the initial value of every block
+template<class Op, class Exec, std::size_t BitWidth, typename BackingStorage>
+auto _batch_reduce(Exec&& exec,
+                   std::span<const multiple_int<BitWidth, BackingStorage>> x,
+                   multiple_int<BitWidth, BackingStorage> init,
+                   multiple_int<BitWidth, BackingStorage> identity) -> multiple_int<BitWidth, BackingStorage>
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+
+  static const auto kernel = _dispatched_kernel<_batch_reduce_kernel<Op>, const T*, std::size_t, T*>();
+
+  return _transform_reduce_blocks(std::forward<Exec>(exec),
+                                  x.size(),
+                                  init,
+                                  Op {},
+                                  [&](std::size_t first, std::size_t count) -> T
+                                  {
+                                    auto partial = identity;
+                                    kernel(x.data() + first, count, &partial);
+
+                                    return partial;
+                                  });
+}
+}  // namespace detail
+
+// The following array algorithms run on batches as wide as the registers of the most capable instruction set
+// of the CPU (see best_isa()), which is detected at the first call. x, y and z have to have the same size.
+
+// z[i] = x[i] + y[i]
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+void xpy(Exec&& exec,
+         std::span<const multiple_int<BitWidth, BackingStorage>> x,
+         std::span<const multiple_int<BitWidth, BackingStorage>> y,
+         std::span<multiple_int<BitWidth, BackingStorage>> z)
+{
+  detail::_batch_transform<detail::_plus>(std::forward<Exec>(exec), x, y, z);
+}
+
+// z[i] = max(x[i], y[i])
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+void elemwise_max(Exec&& exec,
+                  std::span<const multiple_int<BitWidth, BackingStorage>> x,
+                  std::span<const multiple_int<BitWidth, BackingStorage>> y,
+                  std::span<multiple_int<BitWidth, BackingStorage>> z)
+{
+  detail::_batch_transform<detail::_maximum>(std::forward<Exec>(exec), x, y, z);
+}
+
+// Mixed layouts: x holds multiple_int<BitWidth, BackingStorage>, y and z the multiple_ints with
+// 2 * BitWidth + 1 bits and twice the storage, which have as many lanes. Every word of x is widened in the
+// registers (see widen), so lane k of x[i] meets lane k of y[i] without a widened copy of x in memory.
+
+// z[i] = widen(x[i]) + y[i]
+/* clang-format off */
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+requires(sizeof(BackingStorage) < sizeof(std::uint64_t))
+void xpy(Exec&& exec,
+         std::span<const multiple_int<BitWidth, BackingStorage>> x,
+         std::span<const detail::_widened_multiple_int<BitWidth, BackingStorage>> y,
+         std::span<detail::_widened_multiple_int<BitWidth, BackingStorage>> z)
+/* clang-format on */
+{
+  detail::_widening_transform<detail::_plus>(std::forward<Exec>(exec), x, y, z);
+}
+
+// z[i] = max(widen(x[i]), y[i])
+/* clang-format off */
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+requires(sizeof(BackingStorage) < sizeof(std::uint64_t))
+void elemwise_max(Exec&& exec,
+                  std::span<const multiple_int<BitWidth, BackingStorage>> x,
+                  std::span<const detail::_widened_multiple_int<BitWidth, BackingStorage>> y,
+                  std::span<detail::_widened_multiple_int<BitWidth, BackingStorage>> z)
+/* clang-format on */
+{
+  detail::_widening_transform<detail::_maximum>(std::forward<Exec>(exec), x, y, z);
+}
+
+// How narrow treats the integers that do not fit into the smaller multiple_int
+enum class narrow_mode : unsigned char
+{
+  truncate,  // keeps their lowest BitWidth bits like the downcasting operator
+  saturate,  // replaces them by the smallest or the largest integer
+};
+
+// The inverse of widen for whole arrays: lane k of in[i] becomes lane k of out[i], out needs room for in.size()
+// words. Returns the number of integers that do not fit into BitWidth bits, which are detected in all lanes at
+// once, so arrays without them are narrowed at the speed of a copy. The carry bits are dropped.
+/* clang-format off */
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+requires(sizeof(BackingStorage) < sizeof(std::uint64_t))
+auto narrow(Exec&& exec,
+            std::span<const detail::_widened_multiple_int<BitWidth, BackingStorage>> in,
+            std::span<multiple_int<BitWidth, BackingStorage>> out,
+            narrow_mode mode = narrow_mode::truncate) -> std::size_t
+/* clang-format on */
+{
+  return detail::_narrow(std::forward<Exec>(exec), in, out, nullptr, mode == narrow_mode::saturate);
+}
+
+// Same as narrow, and the positions of the integers that do not fit are written as a bitmap like the one of
+// range_scan: bit i is set if the integer with the logical index i (word index * IntCount + lane index) does
+// not fit. out_bitmap needs at least ceil(in.size() * IntCount / 64) words.
+/* clang-format off */
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+requires(sizeof(BackingStorage) < sizeof(std::uint64_t))
+auto narrow(Exec&& exec,
+            std::span<const detail::_widened_multiple_int<BitWidth, BackingStorage>> in,
+            std::span<multiple_int<BitWidth, BackingStorage>> out,
+            std::span<std::uint64_t> out_bitmap,
+            narrow_mode mode = narrow_mode::truncate) -> std::size_t
+/* clang-format on */
+{
+  return detail::_narrow(std::forward<Exec>(exec), in, out, out_bitmap.data(), mode == narrow_mode::saturate);
+}
+
+// The sum of init and all words. Like std::reduce, the order of the additions is unspecified, so which carry
+// bits are set may differ between calls if an intermediate sum overflows.
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+auto sum_red(Exec&& exec,
+             std::span<const multiple_int<BitWidth, BackingStorage>> x,
+             multiple_int<BitWidth, BackingStorage> init) -> multiple_int<BitWidth, BackingStorage>
+{
+  return detail::_batch_reduce<detail::_plus>(
+      std::forward<Exec>(exec), x, init, multiple_int<BitWidth, BackingStorage> {});
+}
+
+// The element-wise maximum of init and all words
+template<class Exec, std::size_t BitWidth, typename BackingStorage>
+auto max_red(Exec&& exec,
+             std::span<const multiple_int<BitWidth, BackingStorage>> x,
+             multiple_int<BitWidth, BackingStorage> init) -> multiple_int<BitWidth, BackingStorage>
+{
+  return detail::_batch_reduce<detail::_maximum>(
+      std::forward<Exec>(exec), x, init, std::numeric_limits<multiple_int<BitWidth, BackingStorage>>::lowest());
+}
+
+}  // namespace multipleint
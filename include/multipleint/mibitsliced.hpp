@@ -0,0 +1,292 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace multipleint
+{
+
+// 64 signed BitWidth-bit integers stored bit-sliced: bit k of the integer at index i is bit i of plane k, so
+// BitWidth words hold 64 integers without any carry bits. Every operation is a boolean circuit over the
+// planes, which handles all 64 integers at once. Arithmetic wraps around, overflows are reported separately.
+/* clang-format off */
+template<std::size_t BitWidth>
+requires(BitWidth >= 1 && BitWidth <= 4)
+class bit_sliced
+/* clang-format on */
+{
+public:
+  static constexpr int IntCount = 64;
+
+  static constexpr int min_value = -(1 << (BitWidth - 1));
+  static constexpr int max_value = (1 << (BitWidth - 1)) - 1;
+
+private:
+  static constexpr std::uint64_t all_lanes = ~std::uint64_t {0};
+
+  std::array<std::uint64_t, BitWidth> planes_ {};
+
+public:
+  // Default ctor = all zeros
+  constexpr bit_sliced() = default;
+
+  // Every integer is set to value
+  static constexpr auto broadcast(int value) -> bit_sliced<BitWidth>
+  {
+    bit_sliced<BitWidth> result {};
+
+    for (std::size_t k = 0; k < BitWidth; ++k)
+      result.planes_[k] = ((value >> k) & 1) ? all_lanes : 0;
+
+    return result;
+  }
+
+  /* clang-format off */
+  template<std::size_t AtMostIntCount>
+  requires(AtMostIntCount > 0 && AtMostIntCount <= IntCount)
+  static constexpr auto encode(const std::array<int, AtMostIntCount>& input) -> bit_sliced<BitWidth>
+  /* clang-format on */
+  {
+    bit_sliced<BitWidth> result {};
+
+    for (std::size_t i = 0; i < AtMostIntCount; ++i)
+      result.encode(static_cast<int>(i), input[i]);
+
+    return result;
+  }
+
+  // Replaces the integer at index with the lowest BitWidth bits of value
+  constexpr auto encode(int index, int value) -> void
+  {
+    const auto lane = std::uint64_t {1} << index;
+
+    for (std::size_t k = 0; k < BitWidth; ++k)
+      planes_[k] = ((value >> k) & 1) ? (planes_[k] | lane) : (planes_[k] & ~lane);
+  }
+
+  /* clang-format off */
+  template<std::size_t AtMostIntCount>
+  requires(AtMostIntCount > 0 && AtMostIntCount <= IntCount)
+  constexpr auto decode() const -> std::array<int, AtMostIntCount>
+  /* clang-format on */
+  {
+    std::array<int, AtMostIntCount> result {};
+
+    for (std::size_t i = 0; i < AtMostIntCount; ++i)
+      result[i] = extract(static_cast<int>(i));
+
+    return result;
+  }
+
+  constexpr auto extract(int index) const -> int
+  {
+    int value = 0;
+
+    for (std::size_t k = 0; k < BitWidth; ++k)
+      value |= static_cast<int>((planes_[k] >> index) & 1) << k;
+
+    // Sign extension
+    return (value ^ (1 << (BitWidth - 1))) - (1 << (BitWidth - 1));
+  }
+
+  // Bit k of all integers, plane BitWidth - 1 holds the signs
+  constexpr auto plane(std::size_t k) const -> std::uint64_t { return planes_[k]; }
+
+  constexpr auto operator+(bit_sliced<BitWidth> rhs) const -> bit_sliced<BitWidth> { return add(*this, rhs, 0).sum; }
+
+  constexpr auto operator-(bit_sliced<BitWidth> rhs) const -> bit_sliced<BitWidth>
+  {
+    return add(*this, ~rhs, all_lanes).sum;
+  }
+
+  constexpr auto operator-() const -> bit_sliced<BitWidth> { return bit_sliced<BitWidth> {} - *this; }
+
+  // Returns a bitmask in which bit i is set iff lhs + rhs overflows at index i
+  friend constexpr auto add_overflow(bit_sliced<BitWidth> lhs, bit_sliced<BitWidth> rhs) -> std::uint64_t
+  {
+    return add(lhs, rhs, 0).overflow;
+  }
+
+  // Returns a bitmask in which bit i is set iff lhs - rhs overflows at index i
+  friend constexpr auto subtract_overflow(bit_sliced<BitWidth> lhs, bit_sliced<BitWidth> rhs) -> std::uint64_t
+  {
+    return add(lhs, ~rhs, all_lanes).overflow;
+  }
+
+  friend constexpr auto max(bit_sliced<BitWidth> lhs, bit_sliced<BitWidth> rhs) -> bit_sliced<BitWidth>
+  {
+    return select(less(lhs, rhs), rhs, lhs);
+  }
+
+  friend constexpr auto min(bit_sliced<BitWidth> lhs, bit_sliced<BitWidth> rhs) -> bit_sliced<BitWidth>
+  {
+    return select(less(lhs, rhs), lhs, rhs);
+  }
+
+  // Returns a bitmask in which bit i is set iff lhs < rhs at index i
+  friend constexpr auto less(bit_sliced<BitWidth> lhs, bit_sliced<BitWidth> rhs) -> std::uint64_t
+  {
+    // From the sign plane down, the first plane in which both differ decides. A set sign bit is the smaller.
+    std::uint64_t smaller = lhs.planes_[BitWidth - 1] & ~rhs.planes_[BitWidth - 1];
+    std::uint64_t equal = ~(lhs.planes_[BitWidth - 1] ^ rhs.planes_[BitWidth - 1]);
+
+    for (std::size_t k = BitWidth - 1; k-- > 0 && equal != 0;) {
+      smaller |= equal & ~lhs.planes_[k] & rhs.planes_[k];
+      equal &= ~(lhs.planes_[k] ^ rhs.planes_[k]);
+    }
+
+    return smaller;
+  }
+
+  // Returns the sum of all stored values
+  constexpr auto sum() const -> std::int64_t
+  {
+    std::int64_t result = 0;
+
+    for (std::size_t k = 0; k < BitWidth; ++k) {
+      const auto weight = (k == BitWidth - 1) ? -(std::int64_t {1} << k) : (std::int64_t {1} << k);
+
+      result += weight * std::popcount(planes_[k]);
+    }
+
+    return result;
+  }
+
+  // Returns the maximum of all stored values
+  constexpr auto max() const -> int
+  {
+    // From the sign plane down, keep the candidates with the larger bit if there are any
+    std::uint64_t candidates = all_lanes;
+    int result = 0;
+
+    for (std::size_t k = BitWidth; k-- > 0;) {
+      const bool sign = k == BitWidth - 1;
+      const auto larger_bit = candidates & (sign ? ~planes_[k] : planes_[k]);
+
+      if (larger_bit != 0) {
+        candidates = larger_bit;
+        result += sign ? 0 : (1 << k);
+      } else if (sign) {
+        result = min_value;
+      }
+    }
+
+    return result;
+  }
+
+  // Returns the index of the first value equal to value, IntCount if there is none
+  constexpr auto find_lane(int value) const -> int
+  {
+    const auto matches = equal_lanes(value);
+
+    return (matches == 0) ? IntCount : std::countr_zero(matches);
+  }
+
+  constexpr auto contains(int value) const -> bool { return equal_lanes(value) != 0; }
+
+  // Returns how many stored values are equal to value
+  constexpr auto count(int value) const -> int { return std::popcount(equal_lanes(value)); }
+
+  // Returns a bitmask in which bit i is set iff lo <= (value at index i) <= hi
+  constexpr auto in_range(int lo, int hi) const -> std::uint64_t
+  {
+    if (lo > hi || lo > max_value || hi < min_value)
+      return 0;
+
+    // The bounds that cannot be exceeded by any value are always fulfilled
+    const auto at_least_lo = (lo <= min_value) ? all_lanes : ~below(lo);
+    const auto at_most_hi = (hi >= max_value) ? all_lanes : below(hi + 1);
+
+    return at_least_lo & at_most_hi;
+  }
+
+private:
+  struct add_result
+  {
+    bit_sliced<BitWidth> sum;
+    std::uint64_t overflow;
+  };
+
+  // Ripple-carry adder over the planes
+  static constexpr auto add(bit_sliced<BitWidth> lhs, bit_sliced<BitWidth> rhs, std::uint64_t carry_in) -> add_result
+  {
+    add_result result {};
+    auto carry = carry_in;
+
+    for (std::size_t k = 0; k < BitWidth; ++k) {
+      const auto half = lhs.planes_[k] ^ rhs.planes_[k];
+      const auto carry_out = (lhs.planes_[k] & rhs.planes_[k]) | (carry & half);
+
+      result.sum.planes_[k] = half ^ carry;
+
+      // Signed overflow iff the carry into the sign differs from the carry out of it
+      if (k == BitWidth - 1)
+        result.overflow = carry ^ carry_out;
+
+      carry = carry_out;
+    }
+
+    return result;
+  }
+
+  constexpr auto operator~() const -> bit_sliced<BitWidth>
+  {
+    bit_sliced<BitWidth> result {};
+
+    for (std::size_t k = 0; k < BitWidth; ++k)
+      result.planes_[k] = ~planes_[k];
+
+    return result;
+  }
+
+  // Takes the integers of lhs where mask is set, the others from rhs
+  static constexpr auto select(std::uint64_t mask, bit_sliced<BitWidth> lhs, bit_sliced<BitWidth> rhs)
+      -> bit_sliced<BitWidth>
+  {
+    bit_sliced<BitWidth> result {};
+
+    for (std::size_t k = 0; k < BitWidth; ++k)
+      result.planes_[k] = (lhs.planes_[k] & mask) | (rhs.planes_[k] & ~mask);
+
+    return result;
+  }
+
+  // The bit of every integer equal to value is set. Stops as soon as no integer can match anymore.
+  constexpr auto equal_lanes(int value) const -> std::uint64_t
+  {
+    if (value < min_value || value > max_value)
+      return 0;
+
+    std::uint64_t matches = all_lanes;
+
+    for (std::size_t k = BitWidth; k-- > 0 && matches != 0;)
+      matches &= ((value >> k) & 1) ? planes_[k] : ~planes_[k];
+
+    return matches;
+  }
+
+  // The bit of every integer less than bound (min < bound <= max) is set. The planes are compared from the
+  // sign down and the comparison stops as soon as every integer is decided.
+  constexpr auto below(int bound) const -> std::uint64_t
+  {
+    // A set sign bit is the smaller
+    const bool bound_negative = (bound >> (BitWidth - 1)) & 1;
+
+    std::uint64_t smaller = bound_negative ? 0 : planes_[BitWidth - 1];
+    std::uint64_t equal = bound_negative ? planes_[BitWidth - 1] : ~planes_[BitWidth - 1];
+
+    for (std::size_t k = BitWidth - 1; k-- > 0 && equal != 0;) {
+      if ((bound >> k) & 1) {
+        smaller |= equal & ~planes_[k];
+        equal &= planes_[k];
+      } else {
+        equal &= ~planes_[k];
+      }
+    }
+
+    return smaller;
+  }
+};
+}  // namespace multipleint
@@ -0,0 +1,143 @@
+#pragma once
+
+// Kernels for specific instruction set extensions are compiled with function level target attributes, so they
+// are available without building the whole project for a newer ISA and are only called after checking the CPU
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)) && !defined(__CUDACC__)
+#  define MULTIPLEINT_X86 1
+#  include <immintrin.h>
+#else
+#  define MULTIPLEINT_X86 0
+#endif
+
+#include <cstddef>
+
+namespace multipleint
+{
+
+// Instruction sets the dispatched array kernels are compiled for, ordered by capability
+enum class isa : unsigned char
+{
+  scalar,  // one word at a time in the general-purpose registers
+  sse42,
+  avx2,
+  avx512,  // AVX-512 F and BW
+};
+
+namespace detail
+{
+
+struct _cpu_features
+{
+  bool bmi2 = false;
+  bool sse42 = false;
+  bool avx2 = false;
+  bool avx512 = false;
+};
+
+// Detected once on first use
+inline auto cpu_features() -> const _cpu_features&
+{
+  static const _cpu_features features = []()
+  {
+    _cpu_features result {};
+
+#if MULTIPLEINT_X86
+    __builtin_cpu_init();
+
+    // pdep/pext are microcoded with a latency of hundreds of cycles on AMD before Zen 3
+    result.bmi2 = __builtin_cpu_supports("bmi2") && !__builtin_cpu_is("znver1") && !__builtin_cpu_is("znver2");
+
+    // The checks include the OS support for saving the wider registers
+    result.sse42 = __builtin_cpu_supports("sse4.2");
+    result.avx2 = __builtin_cpu_supports("avx2");
+    result.avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+#endif
+
+    return result;
+  }();
+
+  return features;
+}
+}  // namespace detail
+
+// The most capable instruction set of this CPU that there are kernels for
+inline auto best_isa() -> isa
+{
+  const auto& features = detail::cpu_features();
+
+  if (features.avx512)
+    return isa::avx512;
+
+  if (features.avx2)
+    return isa::avx2;
+
+  if (features.sse42)
+    return isa::sse42;
+
+  return isa::scalar;
+}
+
+namespace detail
+{
+
+// Every kernel is a class with a static template<std::size_t RegisterBytes> run(args...), which is compiled
+// once per instruction set. RegisterBytes is the width of its SIMD registers (0 for the scalar version).
+// flatten inlines everything run calls, so all of it is compiled for the instruction set as well.
+template<class Kernel, class... Args>
+void _run_scalar(Args... args)
+{
+  Kernel::template run<0>(args...);
+}
+
+#if MULTIPLEINT_X86
+template<class Kernel, class... Args>
+__attribute__((target("sse4.2"), flatten)) void _run_sse42(Args... args)
+{
+  Kernel::template run<16>(args...);
+}
+
+template<class Kernel, class... Args>
+__attribute__((target("avx2"), flatten)) void _run_avx2(Args... args)
+{
+  Kernel::template run<32>(args...);
+}
+
+template<class Kernel, class... Args>
+__attribute__((target("avx512f,avx512bw"), flatten)) void _run_avx512(Args... args)
+{
+  Kernel::template run<64>(args...);
+}
+#endif
+
+// The version of Kernel for target, which the CPU has to support
+template<class Kernel, class... Args>
+auto _select_kernel(isa target) -> void (*)(Args...)
+{
+#if MULTIPLEINT_X86
+  switch (target) {
+    case isa::avx512:
+      return &_run_avx512<Kernel, Args...>;
+    case isa::avx2:
+      return &_run_avx2<Kernel, Args...>;
+    case isa::sse42:
+      return &_run_sse42<Kernel, Args...>;
+    case isa::scalar:
+      break;
+  }
+#else
+  static_cast<void>(target);
+#endif
+
+  return &_run_scalar<Kernel, Args...>;
+}
+
+// The version of Kernel for best_isa(), selected on the first call
+template<class Kernel, class... Args>
+auto _dispatched_kernel() -> void (*)(Args...)
+{
+  static const auto kernel = _select_kernel<Kernel, Args...>(best_isa());
+
+  return kernel;
+}
+}  // namespace detail
+}  // namespace multipleint
@@ -0,0 +1,305 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include "mi.hpp"
+#include "mialgorithm.hpp"
+#include "mibatch.hpp"
+#include "micpu.hpp"
+
+namespace multipleint
+{
+
+namespace detail
+{
+
+struct _minus
+{
+  template<class T>
+  auto operator()(const T& lhs, const T& rhs) const -> T
+  {
+    return lhs - rhs;
+  }
+};
+
+struct _negate
+{
+  template<class T>
+  auto operator()(const T& value) const -> T
+  {
+    return -value;
+  }
+};
+
+// Every node of an expression evaluates the word at an index with eval<W>(index), where W is either the
+// multiple_int itself or a multiple_int_batch of it, which then covers the words starting at index
+
+template<typename T>
+class _expr_array
+{
+public:
+  using value_type = T;
+
+  explicit _expr_array(std::span<const T> words)
+      : words_ {words.data()}
+  {
+  }
+
+  template<class W>
+  auto eval(std::size_t index) const -> W
+  {
+    if constexpr (std::is_same_v<W, T>)
+      return words_[index];
+    else
+      return W::load(words_ + index);
+  }
+
+private:
+  const T* words_;
+};
+
+template<typename T>
+class _expr_constant
+{
+public:
+  using value_type = T;
+
+  explicit _expr_constant(T word)
+      : word_ {word}
+  {
+  }
+
+  template<class W>
+  auto eval(std::size_t) const -> W
+  {
+    if constexpr (std::is_same_v<W, T>)
+      return word_;
+    else
+      return W {word_};
+  }
+
+private:
+  T word_;
+};
+
+template<class Op, class Operand>
+class _expr_unary
+{
+public:
+  using value_type = typename Operand::value_type;
+
+  explicit _expr_unary(Operand operand)
+      : operand_ {std::move(operand)}
+  {
+  }
+
+  template<class W>
+  auto eval(std::size_t index) const -> W
+  {
+    return Op {}(operand_.template eval<W>(index));
+  }
+
+private:
+  Operand operand_;
+};
+
+template<class Op, class Lhs, class Rhs>
+class _expr_binary
+{
+public:
+  using value_type = typename Lhs::value_type;
+
+  static_assert(std::is_same_v<value_type, typename Rhs::value_type>, "both operands need the same multiple_int");
+
+  _expr_binary(Lhs lhs, Rhs rhs)
+      : lhs_ {std::move(lhs)}
+      , rhs_ {std::move(rhs)}
+  {
+  }
+
+  template<class W>
+  auto eval(std::size_t index) const -> W
+  {
+    return Op {}(lhs_.template eval<W>(index), rhs_.template eval<W>(index));
+  }
+
+private:
+  Lhs lhs_;
+  Rhs rhs_;
+};
+
+// The multiple_int_batch of WordCount words of T
+template<class T, std::size_t WordCount>
+struct _batch_of;
+
+template<std::size_t BitWidth, typename BackingStorage, std::size_t WordCount>
+struct _batch_of<multiple_int<BitWidth, BackingStorage>, WordCount>
+{
+  using type = multiple_int_batch<BitWidth, BackingStorage, WordCount>;
+};
+
+// Widens every word of the operand (see widen), a batch of the operand covers as many words as one of the result
+template<class Operand>
+class _expr_widen
+{
+  using narrow_type = typename Operand::value_type;
+
+public:
+  using value_type = decltype(widen(std::declval<narrow_type>()));
+
+  explicit _expr_widen(Operand operand)
+      : operand_ {std::move(operand)}
+  {
+  }
+
+  template<class W>
+  auto eval(std::size_t index) const -> W
+  {
+    if constexpr (std::is_same_v<W, value_type>)
+      return widen(operand_.template eval<narrow_type>(index));
+    else
+      return W {operand_.template eval<typename _batch_of<narrow_type, W::size>::type>(index)};
+  }
+
+private:
+  Operand operand_;
+};
+
+template<class E>
+struct _is_expression : std::false_type
+{
+};
+
+template<typename T>
+struct _is_expression<_expr_array<T>> : std::true_type
+{
+};
+
+template<typename T>
+struct _is_expression<_expr_constant<T>> : std::true_type
+{
+};
+
+template<class Op, class Operand>
+struct _is_expression<_expr_unary<Op, Operand>> : std::true_type
+{
+};
+
+template<class Op, class Lhs, class Rhs>
+struct _is_expression<_expr_binary<Op, Lhs, Rhs>> : std::true_type
+{
+};
+
+template<class Operand>
+struct _is_expression<_expr_widen<Operand>> : std::true_type
+{
+};
+
+template<class E>
+concept _expression = _is_expression<std::remove_cvref_t<E>>::value;
+
+// Evaluates count words of the expression starting at first into z, with a batch per register
+struct _expr_kernel
+{
+  template<std::size_t RegisterBytes, class Expr, std::size_t BitWidth, typename BackingStorage>
+  static void run(const Expr* expr, multiple_int<BitWidth, BackingStorage>* z, std::size_t first, std::size_t count)
+  {
+    using T = multiple_int<BitWidth, BackingStorage>;
+
+    auto w = first;
+    const auto last = first + count;
+
+    if constexpr (RegisterBytes != 0) {
+      using batch = multiple_int_batch<BitWidth, BackingStorage, RegisterBytes / sizeof(BackingStorage)>;
+
+      for (; w + batch::size <= last; w += batch::size)
+        expr->template eval<batch>(w).store(z + w);
+    }
+
+    for (; w < last; ++w)
+      z[w] = expr->template eval<T>(w);
+  }
+};
+}  // namespace detail
+
+// Lazy element-wise expressions over arrays of multiple_ints: lazy(x) + lazy(y) - lazy(w) or
+// max(lazy(x) + lazy(y), lazy(w)) only builds the expression, evaluate then computes all operations for a word
+// in one pass over the arrays. Every operation has exactly the semantics of the one on single words, including
+// the carry bits.
+
+template<std::size_t BitWidth, typename BackingStorage>
+auto lazy(std::span<const multiple_int<BitWidth, BackingStorage>> words)
+{
+  return detail::_expr_array<multiple_int<BitWidth, BackingStorage>> {words};
+}
+
+template<std::ranges::contiguous_range R>
+requires(!detail::_expression<R>)
+auto lazy(const R& words)
+{
+  return lazy(std::span<const std::ranges::range_value_t<R>>(words));
+}
+
+// The same word at every index
+template<std::size_t BitWidth, typename BackingStorage>
+auto lazy(multiple_int<BitWidth, BackingStorage> word)
+{
+  return detail::_expr_constant<multiple_int<BitWidth, BackingStorage>> {word};
+}
+
+template<detail::_expression Lhs, detail::_expression Rhs>
+auto operator+(Lhs lhs, Rhs rhs)
+{
+  return detail::_expr_binary<detail::_plus, Lhs, Rhs> {std::move(lhs), std::move(rhs)};
+}
+
+template<detail::_expression Lhs, detail::_expression Rhs>
+auto operator-(Lhs lhs, Rhs rhs)
+{
+  return detail::_expr_binary<detail::_minus, Lhs, Rhs> {std::move(lhs), std::move(rhs)};
+}
+
+template<detail::_expression Operand>
+auto operator-(Operand operand)
+{
+  return detail::_expr_unary<detail::_negate, Operand> {std::move(operand)};
+}
+
+template<detail::_expression Lhs, detail::_expression Rhs>
+auto max(Lhs lhs, Rhs rhs)
+{
+  return detail::_expr_binary<detail::_maximum, Lhs, Rhs> {std::move(lhs), std::move(rhs)};
+}
+
+// The expression on the multiple_int with 2 * BitWidth + 1 bits and twice the storage, e.g. to add an array of
+// multiple_int<7, std::uint32_t> to one of multiple_int<15, std::uint64_t> with lazy(y) + widen(lazy(x)).
+// Every word is widened in the registers, lane k stays lane k.
+template<detail::_expression Operand>
+auto widen(Operand operand)
+{
+  return detail::_expr_widen<Operand> {std::move(operand)};
+}
+
+// z[i] = expr at index i. Every array in expr needs at least z.size() words, z may be one of them. Like the
+// other array algorithms, the batches are as wide as the registers of best_isa().
+template<class Exec, std::size_t BitWidth, typename BackingStorage, detail::_expression Expr>
+void evaluate(Exec&& exec, std::span<multiple_int<BitWidth, BackingStorage>> z, const Expr& expr)
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+
+  static_assert(std::is_same_v<T, typename Expr::value_type>, "z has to hold the multiple_int of the expression");
+
+  static const auto kernel =
+      detail::_dispatched_kernel<detail::_expr_kernel, const Expr*, T*, std::size_t, std::size_t>();
+
+  detail::_for_each_block(std::forward<Exec>(exec),
+                          z.size(),
+                          [&](std::size_t first, std::size_t count) { kernel(&expr, z.data(), first, count); });
+}
+
+}  // namespace multipleint
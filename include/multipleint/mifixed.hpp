@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+
+#include "mi.hpp"
+
+namespace multipleint
+{
+
+// Fixed-point numbers in the lanes of a multiple_int<IntBits + FracBits, BackingStorage> (Q-format): a lane
+// holding the integer v stands for v / 2^FracBits. IntBits includes the sign bit, so packed_fixed<1, 11,
+// std::uint64_t> packs 12-bit samples from [-1, 1). Addition, subtraction, negation, max and min are the ones of
+// multiple_int (including the carry bits), results out of range of the multiplication and rescaling wrap and set
+// their carry bit like an overflowing addition.
+/* clang-format off */
+template<std::size_t IntBits, std::size_t FracBits, std::unsigned_integral BackingStorage>
+requires(IntBits > 0 && IntBits + FracBits < 32 && IntBits + FracBits < 8 * sizeof(BackingStorage))
+class packed_fixed
+/* clang-format on */
+{
+public:
+  using int_type = multiple_int<IntBits + FracBits, BackingStorage>;
+
+  static constexpr std::size_t BitWidth = IntBits + FracBits;
+
+  static constexpr int IntCount = int_type::IntCount;
+
+private:
+  /* clang-format off */
+  template<std::size_t OtherIntBits, std::size_t OtherFracBits, std::unsigned_integral OtherBackingStorage>
+  requires(OtherIntBits > 0 && OtherIntBits + OtherFracBits < 32
+           && OtherIntBits + OtherFracBits < 8 * sizeof(OtherBackingStorage))
+  friend class packed_fixed;  // needed for wrap_lanes in rescale
+  /* clang-format on */
+
+  static constexpr auto int_count = static_cast<std::size_t>(IntCount);
+
+  static constexpr auto min_int = -(std::int64_t {1} << (BitWidth - 1));
+  static constexpr auto max_int = (std::int64_t {1} << (BitWidth - 1)) - 1;
+
+  static constexpr auto scale = static_cast<double>(std::int64_t {1} << FracBits);
+
+  int_type value_ {};
+
+  // Encodes the lanes, values out of range wrap and set their carry bit
+  static constexpr auto wrap_lanes(const std::array<std::int64_t, int_count>& lanes, BackingStorage carries)
+      -> packed_fixed
+  {
+    constexpr auto mask = (std::uint64_t {1} << BitWidth) - 1;
+
+    auto bits = static_cast<std::uint64_t>(carries);
+
+    for (std::size_t i = 0; i < int_count; ++i) {
+      const auto shift = i * (BitWidth + 1);
+
+      bits |= (static_cast<std::uint64_t>(lanes[i]) & mask) << shift;
+
+      if (lanes[i] < min_int || lanes[i] > max_int)
+        bits |= std::uint64_t {1} << (shift + BitWidth);
+    }
+
+    return packed_fixed {detail::_multiple_int_access::make<int_type>(static_cast<BackingStorage>(bits))};
+  }
+
+  constexpr auto lanes() const -> std::array<std::int64_t, int_count>
+  {
+    const auto ints = value_.template decode<int_count>();
+
+    std::array<std::int64_t, int_count> result {};
+
+    std::copy(ints.begin(), ints.end(), result.begin());
+
+    return result;
+  }
+
+  // value * 2^FracBits rounded to nearest (ties away from zero) and clamped to the lane, NaN becomes 0
+  static constexpr auto to_lane(float value) -> int
+  {
+    if (value != value)
+      return 0;
+
+    const auto scaled = static_cast<double>(value) * scale;
+
+    if (scaled <= static_cast<double>(min_int))
+      return static_cast<int>(min_int);
+
+    if (scaled >= static_cast<double>(max_int))
+      return static_cast<int>(max_int);
+
+    return static_cast<int>(scaled < 0 ? scaled - 0.5 : scaled + 0.5);
+  }
+
+  // (value + half) >> shift, i.e. value / 2^shift rounded to nearest with ties rounded up
+  static constexpr auto round_shift(std::int64_t value, std::size_t shift) -> std::int64_t
+  {
+    if (shift == 0)
+      return value;
+
+    return (value + (std::int64_t {1} << (shift - 1))) >> shift;
+  }
+
+public:
+  // Default ctor = all zeros
+  constexpr packed_fixed() = default;
+
+  // The fixed-point numbers with the integers of bits, e.g. the result of array algorithms on the lanes
+  constexpr explicit packed_fixed(int_type bits)
+      : value_ {bits}
+  {
+  }
+
+  constexpr auto bits() const -> int_type { return value_; }
+
+  constexpr auto carry() const -> BackingStorage { return value_.carry(); }
+
+  static constexpr auto from_float(const std::array<float, int_count>& values) -> packed_fixed
+  {
+    std::array<int, int_count> ints {};
+
+    std::transform(values.begin(), values.end(), ints.begin(), to_lane);
+
+    return packed_fixed {int_type::encode(ints)};
+  }
+
+  static constexpr auto broadcast(float value) -> packed_fixed
+  {
+    return packed_fixed {int_type::broadcast(to_lane(value))};
+  }
+
+  constexpr auto to_float() const -> std::array<float, int_count>
+  {
+    const auto ints = value_.template decode<int_count>();
+
+    std::array<float, int_count> result {};
+
+    std::transform(
+        ints.begin(), ints.end(), result.begin(), [](int v) { return static_cast<float>(v / scale); });
+
+    return result;
+  }
+
+  constexpr auto operator+(packed_fixed rhs) const -> packed_fixed { return packed_fixed {value_ + rhs.value_}; }
+
+  constexpr auto operator-(packed_fixed rhs) const -> packed_fixed { return packed_fixed {value_ - rhs.value_}; }
+
+  constexpr auto operator-() const -> packed_fixed { return packed_fixed {-value_}; }
+
+  constexpr friend auto max(packed_fixed lhs, packed_fixed rhs) -> packed_fixed
+  {
+    return packed_fixed {max(lhs.value_, rhs.value_)};
+  }
+
+  constexpr friend auto min(packed_fixed lhs, packed_fixed rhs) -> packed_fixed
+  {
+    return packed_fixed {min(lhs.value_, rhs.value_)};
+  }
+
+  // Lane-wise product rounded to nearest with ties rounded up, the carry bits of both operands are kept.
+  // Products out of range wrap and set their carry bit.
+  constexpr auto operator*(packed_fixed rhs) const -> packed_fixed
+  {
+    const auto lhs_lanes = lanes();
+    const auto rhs_lanes = rhs.lanes();
+
+    std::array<std::int64_t, int_count> products {};
+
+    for (std::size_t i = 0; i < int_count; ++i)
+      products[i] = round_shift(lhs_lanes[i] * rhs_lanes[i], FracBits);
+
+    return wrap_lanes(products, static_cast<BackingStorage>(carry() | rhs.carry()));
+  }
+
+  // The same numbers with NewFracBits fraction bits in the same lanes: fewer fraction bits round to nearest with
+  // ties rounded up, more fraction bits shift out integer bits and set the carry bit of lanes that overflow
+  /* clang-format off */
+  template<std::size_t NewFracBits>
+  requires(NewFracBits < BitWidth)
+  constexpr auto rescale() const -> packed_fixed<BitWidth - NewFracBits, NewFracBits, BackingStorage>
+  /* clang-format on */
+  {
+    using result_type = packed_fixed<BitWidth - NewFracBits, NewFracBits, BackingStorage>;
+
+    auto result = lanes();
+
+    for (auto& lane : result) {
+      if constexpr (NewFracBits < FracBits)
+        lane = round_shift(lane, FracBits - NewFracBits);
+      else
+        lane *= std::int64_t {1} << (NewFracBits - FracBits);
+    }
+
+    return result_type::wrap_lanes(result, carry());
+  }
+};
+}  // namespace multipleint
@@ -0,0 +1,287 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "mi.hpp"
+
+namespace multipleint
+{
+
+// The smallest BitWidth for which a for_block can hold values from [min, max]
+constexpr auto for_bit_width(std::int64_t min, std::int64_t max) -> std::size_t
+{
+  const auto range = static_cast<std::uint64_t>(max) - static_cast<std::uint64_t>(min);
+
+  return std::max<std::size_t>(1, static_cast<std::size_t>(std::bit_width(range)));
+}
+
+namespace detail
+{
+// The base for values from [lo, lo + max_offset - min_offset]: lo becomes min_offset unless the base would
+// overflow, then the largest int64 becomes max_offset
+constexpr auto _frame_base(std::int64_t lo, std::int64_t min_offset, std::int64_t max_offset) -> std::int64_t
+{
+  return (lo <= std::numeric_limits<std::int64_t>::max() + min_offset)
+      ? lo - min_offset
+      : std::numeric_limits<std::int64_t>::max() - max_offset;
+}
+
+// value - base clamped to [min_offset - 1, max_offset + 1], computed without overflowing
+constexpr auto _frame_offset(std::int64_t base, std::int64_t value, std::int64_t min_offset, std::int64_t max_offset)
+    -> std::int64_t
+{
+  if (value < base) {
+    const auto distance = static_cast<std::uint64_t>(base) - static_cast<std::uint64_t>(value);
+
+    return (distance > static_cast<std::uint64_t>(-min_offset)) ? min_offset - 1
+                                                                : -static_cast<std::int64_t>(distance);
+  }
+
+  const auto distance = static_cast<std::uint64_t>(value) - static_cast<std::uint64_t>(base);
+
+  return (distance > static_cast<std::uint64_t>(max_offset)) ? max_offset + 1 : static_cast<std::int64_t>(distance);
+}
+
+// The bounds of lo <= value <= hi for the offsets to base, std::nullopt if no offset can be in range
+constexpr auto _frame_offset_range(
+    std::int64_t base, std::int64_t lo, std::int64_t hi, std::int64_t min_offset, std::int64_t max_offset)
+    -> std::optional<std::array<int, 2>>
+{
+  const auto lo_offset = std::max(_frame_offset(base, lo, min_offset, max_offset), min_offset);
+  const auto hi_offset = std::min(_frame_offset(base, hi, min_offset, max_offset), max_offset);
+
+  if (lo > hi || lo_offset > max_offset || hi_offset < min_offset)
+    return std::nullopt;
+
+  return std::array {static_cast<int>(lo_offset), static_cast<int>(hi_offset)};
+}
+}  // namespace detail
+
+// Frame-of-reference block: up to size int64 values stored as a base and the offsets value - base, which are
+// packed into WordCount multiple_ints. sum, max and the range scans fold the base in without decoding the
+// offsets, so large values with a small range within the block cost only BitWidth + 1 bits each. The offsets
+// are encoded and scanned as ints, so BitWidth is at most 32.
+/* clang-format off */
+template<std::size_t BitWidth, std::unsigned_integral BackingStorage, std::size_t WordCount = 16>
+requires(WordCount > 0 && BitWidth <= 32)
+class for_block
+/* clang-format on */
+{
+public:
+  using word_type = multiple_int<BitWidth, BackingStorage>;
+
+  static constexpr std::size_t size = WordCount * static_cast<std::size_t>(word_type::IntCount);
+
+  // Offsets that can be stored
+  static constexpr std::int64_t min_offset = -(std::int64_t {1} << (BitWidth - 1));
+  static constexpr std::int64_t max_offset = (std::int64_t {1} << (BitWidth - 1)) - 1;
+
+private:
+  static constexpr auto int_count = static_cast<std::size_t>(word_type::IntCount);
+
+  std::int64_t base_ = 0;
+  std::size_t count_ = 0;
+  std::array<word_type, WordCount> words_ {};
+
+public:
+  // Default ctor = empty block
+  constexpr for_block() = default;
+
+  // Packs at most size values, std::nullopt if there are more or their range does not fit into BitWidth bits
+  // (see for_bit_width). Unused lanes are filled with min_offset.
+  static constexpr auto encode(std::span<const std::int64_t> values) -> std::optional<for_block>
+  {
+    if (values.size() > size)
+      return std::nullopt;
+
+    for_block result {};
+
+    result.count_ = values.size();
+    result.words_.fill(word_type::broadcast(static_cast<int>(min_offset)));
+
+    if (values.empty())
+      return result;
+
+    const auto [min, max] = std::minmax_element(values.begin(), values.end());
+
+    if (for_bit_width(*min, *max) > BitWidth)
+      return std::nullopt;
+
+    result.base_ = detail::_frame_base(*min, min_offset, max_offset);
+
+    for (std::size_t w = 0; w * int_count < values.size(); ++w) {
+      std::array<int, int_count> offsets {};
+      offsets.fill(static_cast<int>(min_offset));
+
+      for (std::size_t i = 0; i < int_count && w * int_count + i < values.size(); ++i)
+        offsets[i] = static_cast<int>(values[w * int_count + i] - result.base_);
+
+      result.words_[w] = word_type::encode(offsets);
+    }
+
+    return result;
+  }
+
+  // Unpacks the count() values into out
+  constexpr auto decode(std::span<std::int64_t> out) const -> void
+  {
+    for (std::size_t w = 0; w * int_count < count_; ++w) {
+      const auto offsets = words_[w].template decode<int_count>();
+
+      for (std::size_t i = 0; i < int_count && w * int_count + i < count_; ++i)
+        out[w * int_count + i] = base_ + offsets[i];
+    }
+  }
+
+  constexpr auto count() const -> std::size_t { return count_; }
+
+  constexpr auto base() const -> std::int64_t { return base_; }
+
+  constexpr auto words() const -> std::span<const word_type, WordCount> { return words_; }
+
+  // Returns the sum of all values, wrapping around like unsigned arithmetic if it exceeds the int64 range
+  constexpr auto sum() const -> std::int64_t
+  {
+    auto offsets = static_cast<std::int64_t>(size - count_) * -min_offset;
+
+    for (const auto& word : words_)
+      offsets += word.sum();
+
+    return static_cast<std::int64_t>(static_cast<std::uint64_t>(base_) * count_ + static_cast<std::uint64_t>(offsets));
+  }
+
+  // Returns the maximum of all values, the lowest int64 for an empty block
+  constexpr auto max() const -> std::int64_t
+  {
+    if (count_ == 0)
+      return std::numeric_limits<std::int64_t>::lowest();
+
+    auto result = words_[0].max();
+
+    for (std::size_t w = 1; w < WordCount; ++w)
+      result = std::max(result, words_[w].max());
+
+    return base_ + result;
+  }
+
+  // Returns the bounds of lo <= value <= hi for the offsets, std::nullopt if no offset can be in range
+  constexpr auto offset_range(std::int64_t lo, std::int64_t hi) const -> std::optional<std::array<int, 2>>
+  {
+    if (count_ == 0)
+      return std::nullopt;
+
+    return detail::_frame_offset_range(base_, lo, hi, min_offset, max_offset);
+  }
+
+  // Returns a bitmask in which bit i is set iff the offset at index i of word lies in range (from offset_range).
+  // Unused lanes are never set.
+  constexpr auto word_in_range(std::size_t word, std::array<int, 2> range) const -> std::uint64_t
+  {
+    const auto mask = words_[word].in_range(range[0], range[1]);
+    const auto first = word * int_count;
+
+    if (first + int_count <= count_)
+      return mask;
+
+    return (first >= count_) ? 0 : mask & ((std::uint64_t {1} << (count_ - first)) - 1);
+  }
+};
+
+// Returns the sum of all values of all blocks, wrapping around like unsigned arithmetic if it exceeds the int64
+// range
+template<class Exec, std::size_t BitWidth, typename BackingStorage, std::size_t WordCount>
+auto sum_red(Exec&& exec, std::span<const for_block<BitWidth, BackingStorage, WordCount>> blocks) -> std::int64_t
+{
+  using block_type = for_block<BitWidth, BackingStorage, WordCount>;
+
+  return static_cast<std::int64_t>(
+      std::transform_reduce(std::forward<Exec>(exec),
+                            blocks.begin(),
+                            blocks.end(),
+                            std::uint64_t {0},
+                            std::plus<std::uint64_t>(),
+                            [](const block_type& block) { return static_cast<std::uint64_t>(block.sum()); }));
+}
+
+// Returns the maximum of all values of all blocks, the lowest int64 if there are none
+template<class Exec, std::size_t BitWidth, typename BackingStorage, std::size_t WordCount>
+auto max_red(Exec&& exec, std::span<const for_block<BitWidth, BackingStorage, WordCount>> blocks) -> std::int64_t
+{
+  using block_type = for_block<BitWidth, BackingStorage, WordCount>;
+
+  return std::transform_reduce(
+      std::forward<Exec>(exec),
+      blocks.begin(),
+      blocks.end(),
+      std::numeric_limits<std::int64_t>::lowest(),
+      [](std::int64_t x, std::int64_t y) { return std::max(x, y); },
+      [](const block_type& block) { return block.max(); });
+}
+
+// Evaluates lo <= x <= hi for every value and writes the results as a bitmap: bit j of out_bitmap[k] belongs
+// to the value with the index 64 * k + j, where value i of a block has the index block index * size + i.
+// Only the last block may hold less than size values. out_bitmap needs room for at least
+// ceil(blocks.size() * size / 64) words.
+template<class Exec, std::size_t BitWidth, typename BackingStorage, std::size_t WordCount>
+void range_scan(Exec&& exec,
+                std::span<const for_block<BitWidth, BackingStorage, WordCount>> blocks,
+                std::int64_t lo,
+                std::int64_t hi,
+                std::span<std::uint64_t> out_bitmap)
+{
+  using block_type = for_block<BitWidth, BackingStorage, WordCount>;
+
+  constexpr std::size_t bitmap_bits = 64;
+  constexpr auto int_count = static_cast<std::size_t>(block_type::word_type::IntCount);
+
+  const auto words = blocks.size() * WordCount;
+  const auto bitmap_words = (words * int_count + bitmap_bits - 1) / bitmap_bits;
+
+  std::vector<std::size_t> indices(bitmap_words);
+  std::iota(indices.begin(), indices.end(), std::size_t {0});
+
+  // Every bitmap word is assembled from all multiple_ints overlapping it, the bounds of the offsets are
+  // computed once per block
+  std::for_each(std::forward<Exec>(exec),
+                indices.begin(),
+                indices.end(),
+                [&](std::size_t index)
+                {
+                  const auto first = index * bitmap_bits;
+
+                  std::uint64_t bits = 0;
+                  std::size_t block_index = blocks.size();
+                  std::optional<std::array<int, 2>> range;
+
+                  const auto end = std::min(words, (first + bitmap_bits + int_count - 1) / int_count);
+
+                  for (auto word = first / int_count; word < end; ++word) {
+                    if (word / WordCount != block_index) {
+                      block_index = word / WordCount;
+                      range = blocks[block_index].offset_range(lo, hi);
+                    }
+
+                    if (!range)
+                      continue;
+
+                    const auto mask = blocks[block_index].word_in_range(word % WordCount, *range);
+                    const auto position = word * int_count;
+
+                    bits |= (position < first) ? (mask >> (first - position)) : (mask << (position - first));
+                  }
+
+                  out_bitmap[index] = bits;
+                });
+}
+}  // namespace multipleint
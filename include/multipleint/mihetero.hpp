@@ -0,0 +1,263 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+#include "miswar.hpp"
+#include "mitraits.hpp"
+
+namespace multipleint
+{
+
+namespace detail
+{
+// The masks of lanes with individual widths: a lane of Width bits and its carry bit start at bit Offset, the
+// following lanes right after it (generated like _int_mask and _carry_mask for lanes of one width)
+template<typename BackingStorage, std::size_t Offset, std::size_t... Widths>
+struct _hetero_masks
+{
+  static constexpr BackingStorage int_mask = 0;
+  static constexpr BackingStorage carry_mask = 0;
+  static constexpr BackingStorage sign_mask = 0;
+
+  // Number of bits taken by all lanes
+  static constexpr std::size_t bits = Offset;
+};
+
+template<typename BackingStorage, std::size_t Offset, std::size_t Width, std::size_t... Widths>
+struct _hetero_masks<BackingStorage, Offset, Width, Widths...>
+{
+  using rest = _hetero_masks<BackingStorage, Offset + Width + 1, Widths...>;
+
+  static constexpr BackingStorage pattern = (static_cast<BackingStorage>(1) << Width) - 1;
+
+  static constexpr BackingStorage int_mask = static_cast<BackingStorage>(pattern << Offset) | rest::int_mask;
+
+  static constexpr BackingStorage carry_mask =
+      static_cast<BackingStorage>(static_cast<BackingStorage>(1) << (Offset + Width)) | rest::carry_mask;
+
+  static constexpr BackingStorage sign_mask =
+      static_cast<BackingStorage>(static_cast<BackingStorage>(1) << (Offset + Width - 1)) | rest::sign_mask;
+
+  static constexpr std::size_t bits = rest::bits;
+};
+
+// The layout of hetero_int for the lane arithmetic of _swar_arithmetic
+template<typename BackingStorage, std::size_t... Widths>
+struct _hetero_traits
+{
+  using masks = _hetero_masks<BackingStorage, 0, Widths...>;
+
+  static constexpr std::size_t int_count = sizeof...(Widths);
+
+  static constexpr std::array<std::size_t, int_count> widths {Widths...};
+
+  // The first bit of every lane
+  static constexpr std::array<std::size_t, int_count> offsets = []() consteval
+  {
+    std::array<std::size_t, int_count> result {};
+
+    for (std::size_t i = 1; i < int_count; ++i)
+      result[i] = result[i - 1] + widths[i - 1] + 1;
+
+    return result;
+  }();
+
+  static constexpr BackingStorage int_mask = masks::int_mask;
+
+  static constexpr BackingStorage carry_mask = masks::carry_mask;
+
+  static constexpr BackingStorage sign_mask = masks::sign_mask;
+
+  static constexpr BackingStorage empty_mask = (masks::bits == 8 * sizeof(BackingStorage))
+      ? static_cast<BackingStorage>(0)
+      : static_cast<BackingStorage>(~((static_cast<BackingStorage>(1) << masks::bits) - 1));
+
+  // The sign bits of all lanes of the same width move by the same distance, so there is one shift per width
+  template<class Word>
+  static constexpr auto signs_to_lowest_bits(Word signs) -> Word
+  {
+    return [signs]<std::size_t... Idx>(std::index_sequence<Idx...>) constexpr
+    {
+      Word result {};
+
+      ((result = static_cast<Word>(result | shift_width<Idx>(signs))), ...);
+
+      return result;
+    }(std::make_index_sequence<int_count> {});
+  }
+
+private:
+  // Moves the sign bits of all lanes as wide as lane Idx, if lane Idx is the first of them
+  template<std::size_t Idx, class Word>
+  static constexpr auto shift_width(Word signs) -> Word
+  {
+    constexpr auto first_of_width = []() consteval
+    {
+      for (std::size_t i = 0; i < Idx; ++i) {
+        if (widths[i] == widths[Idx])
+          return false;
+      }
+
+      return true;
+    }();
+
+    constexpr auto width_signs = []() consteval
+    {
+      BackingStorage mask = 0;
+
+      for (std::size_t i = 0; i < int_count; ++i) {
+        if (widths[i] == widths[Idx])
+          mask |= static_cast<BackingStorage>(static_cast<BackingStorage>(1) << (offsets[i] + widths[i] - 1));
+      }
+
+      return mask;
+    }();
+
+    if constexpr (first_of_width)
+      return static_cast<Word>(static_cast<Word>(signs & width_signs) >> (widths[Idx] - 1));
+    else
+      return Word {};
+  }
+};
+}  // namespace detail
+
+// Like multiple_int, but every integer has its own number of bits: hetero_int<std::uint64_t, 5, 11, 16, 28>
+// stores a 5, an 11, a 16 and a 28-bit integer, each followed by its carry bit, in one std::uint64_t. The lane
+// arithmetic is the one of multiple_int (including the carry bits), only with the masks of this layout.
+/* clang-format off */
+template<std::unsigned_integral BackingStorage, std::size_t... Widths>
+requires(sizeof...(Widths) > 0 && ((Widths > 0) && ...)
+         && ((Widths + 1) + ...) <= 8 * sizeof(BackingStorage))
+class hetero_int
+/* clang-format on */
+{
+public:
+  static constexpr int IntCount = sizeof...(Widths);
+
+  using traits = detail::_hetero_traits<BackingStorage, Widths...>;
+
+  using swar = detail::_swar_arithmetic<traits, BackingStorage>;
+
+  // The number of bits of the integer at Index
+  template<std::size_t Index>
+  static constexpr std::size_t bit_width = traits::widths[Index];
+
+private:
+  /* clang-format off */
+  template<std::unsigned_integral OtherBackingStorage, std::size_t... OtherWidths>
+  requires(sizeof...(OtherWidths) > 0 && ((OtherWidths > 0) && ...)
+           && ((OtherWidths + 1) + ...) <= 8 * sizeof(OtherBackingStorage))
+  friend class hetero_int;
+  /* clang-format on */
+
+  constexpr explicit hetero_int(BackingStorage value)
+      : value_ {value}
+  {
+  }
+
+  BackingStorage value_ = 0;
+
+public:
+  // Default ctor = all zeros
+  constexpr hetero_int() = default;
+
+  /* clang-format off */
+  template<std::size_t Index, typename T = std::make_signed_t<BackingStorage>>
+  requires(Index < IntCount)
+  constexpr auto extract() const -> T
+  /* clang-format on */
+  {
+    constexpr auto width = traits::widths[Index];
+    constexpr auto mask = (static_cast<BackingStorage>(1) << width) - 1;
+    constexpr auto sign = static_cast<BackingStorage>(1) << (width - 1);
+
+    const auto val = static_cast<BackingStorage>((value_ >> traits::offsets[Index]) & mask);
+
+    // Sign-extend from the width of the integer
+    return static_cast<T>(static_cast<std::make_signed_t<BackingStorage>>(val ^ sign)
+                          - static_cast<std::make_signed_t<BackingStorage>>(sign));
+  }
+
+  /* clang-format off */
+  template<std::size_t Index, bool ClearField = true>
+  requires(Index < IntCount)
+  constexpr auto encode(int input) -> void
+  /* clang-format on */
+  {
+    constexpr auto mask = (static_cast<BackingStorage>(1) << traits::widths[Index]) - 1;
+    constexpr auto shift = traits::offsets[Index];
+
+    if constexpr (ClearField)
+      value_ &= static_cast<BackingStorage>(~(mask << shift));
+
+    value_ |= static_cast<BackingStorage>((static_cast<BackingStorage>(input) & mask) << shift);
+  }
+
+  static constexpr auto encode(const std::array<int, sizeof...(Widths)>& input) -> hetero_int
+  {
+    return [&input]<std::size_t... Idx>(std::index_sequence<Idx...>) constexpr
+    {
+      hetero_int result {};
+
+      (result.encode<Idx, false>(std::get<Idx>(input)), ...);
+
+      return result;
+    }(std::make_index_sequence<sizeof...(Widths)> {});
+  }
+
+  constexpr auto decode() const -> std::array<int, sizeof...(Widths)>
+  {
+    return [this]<std::size_t... Idx>(std::index_sequence<Idx...>) constexpr
+    {
+      return std::array<int, sizeof...(Widths)> {static_cast<int>(extract<Idx>())...};
+    }(std::make_index_sequence<sizeof...(Widths)> {});
+  }
+
+  constexpr BackingStorage intv() const { return this->value_ & traits::int_mask; }
+
+  constexpr BackingStorage carry() const { return this->value_ & traits::carry_mask; }
+
+  constexpr auto operator+(hetero_int rhs) const -> hetero_int { return hetero_int {swar::add(value_, rhs.value_)}; }
+
+  constexpr auto operator-(hetero_int rhs) const -> hetero_int
+  {
+    return hetero_int {swar::subtract(value_, rhs.value_)};
+  }
+
+  constexpr auto operator-() const -> hetero_int { return hetero_int {swar::negate(value_)}; }
+
+  constexpr friend auto max(hetero_int lhs, hetero_int rhs) -> hetero_int
+  {
+    return hetero_int {swar::max(lhs.value_, rhs.value_)};
+  }
+
+  constexpr friend auto min(hetero_int lhs, hetero_int rhs) -> hetero_int
+  {
+    const auto max_mask = swar::max_select_mask(lhs.value_, rhs.value_);
+
+    // Select the value that was not selected by max
+    return hetero_int {static_cast<BackingStorage>((rhs.value_ & max_mask) | (lhs.value_ & ~max_mask))};
+  }
+
+  // Upcast into twice the storage, every integer keeps its lane with 2 * Width + 1 bits (see widen of
+  // multiple_int). The carry bits are cleared.
+  constexpr friend auto widen(hetero_int mi) requires(sizeof(BackingStorage) < sizeof(std::uint64_t))
+  {
+    using wide_type = hetero_int<typename detail::_next_widest<BackingStorage>::type, (2 * Widths + 1)...>;
+
+    return [mi]<std::size_t... Idx>(std::index_sequence<Idx...>) constexpr
+    {
+      wide_type result {};
+
+      (result.template encode<Idx, false>(static_cast<int>(mi.template extract<Idx>())), ...);
+
+      return result;
+    }(std::make_index_sequence<sizeof...(Widths)> {});
+  }
+};
+}  // namespace multipleint
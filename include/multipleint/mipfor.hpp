@@ -0,0 +1,500 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "mi.hpp"
+#include "miframe.hpp"
+
+namespace multipleint
+{
+
+namespace detail
+{
+
+template<typename BackingStorage>
+constexpr auto _pfor_int_count(std::size_t bit_width) -> std::size_t
+{
+  return 8 * sizeof(BackingStorage) / (bit_width + 1);
+}
+
+// Offsets are passed as int, so a block uses at most 31 bits per value
+template<typename BackingStorage>
+inline constexpr std::size_t _pfor_max_bit_width = std::min<std::size_t>(31, 8 * sizeof(BackingStorage) - 1);
+
+// Only the largest BitWidth of every IntCount is worth picking, a smaller one would occupy as many words
+template<typename BackingStorage>
+constexpr auto _pfor_is_candidate(std::size_t bit_width) -> bool
+{
+  return bit_width == _pfor_max_bit_width<BackingStorage>
+      || _pfor_int_count<BackingStorage>(bit_width) != _pfor_int_count<BackingStorage>(bit_width + 1);
+}
+
+template<typename BackingStorage>
+inline constexpr auto _pfor_bit_widths = []() consteval
+{
+  constexpr auto count = []()
+  {
+    std::size_t result = 0;
+
+    for (std::size_t b = 1; b <= _pfor_max_bit_width<BackingStorage>; ++b)
+      result += _pfor_is_candidate<BackingStorage>(b) ? 1U : 0U;
+
+    return result;
+  }();
+
+  std::array<std::size_t, count> result {};
+  std::size_t i = 0;
+
+  for (std::size_t b = 1; b <= _pfor_max_bit_width<BackingStorage>; ++b)
+    if (_pfor_is_candidate<BackingStorage>(b))
+      result[i++] = b;
+
+  return result;
+}();
+
+// The packed offsets of a block of a pfor_array: count values relative to base in ceil(count / IntCount) words.
+// The lanes of the exceptions and the padding lanes of the last word hold the offset of a value of the block.
+template<typename BackingStorage>
+struct _pfor_block
+{
+  std::int64_t base;
+  const BackingStorage* words;
+  std::size_t count;
+};
+
+// The kernels run on the multiple_int of the BitWidth picked for the block
+
+struct _pfor_encode_kernel
+{
+  // offsets holds ceil(count / IntCount) * IntCount offsets
+  template<std::size_t BitWidth, typename BackingStorage>
+  static void run(const int* offsets, std::size_t count, BackingStorage* words)
+  {
+    using T = multiple_int<BitWidth, BackingStorage>;
+
+    constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+    for (std::size_t w = 0; w * int_count < count; ++w) {
+      std::array<int, int_count> lanes {};
+      std::copy_n(offsets + w * int_count, int_count, lanes.begin());
+
+      words[w] = _multiple_int_access::value(T::encode(lanes));
+    }
+  }
+};
+
+struct _pfor_decode_kernel
+{
+  template<std::size_t BitWidth, typename BackingStorage>
+  static void run(const _pfor_block<BackingStorage>& block, std::int64_t* out)
+  {
+    using T = multiple_int<BitWidth, BackingStorage>;
+
+    constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+    for (std::size_t w = 0; w * int_count < block.count; ++w) {
+      const auto offsets = _multiple_int_access::make<T>(block.words[w]).template decode<int_count>();
+
+      for (std::size_t i = 0; i < int_count && w * int_count + i < block.count; ++i)
+        out[w * int_count + i] = block.base + offsets[i];
+    }
+  }
+};
+
+// The sum of the offsets of all lanes including the padding
+struct _pfor_sum_kernel
+{
+  template<std::size_t BitWidth, typename BackingStorage>
+  static auto run(const _pfor_block<BackingStorage>& block) -> std::int64_t
+  {
+    using T = multiple_int<BitWidth, BackingStorage>;
+
+    constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+    std::int64_t result = 0;
+
+    for (std::size_t w = 0; w * int_count < block.count; ++w)
+      result += _multiple_int_access::make<T>(block.words[w]).sum();
+
+    return result;
+  }
+};
+
+// The largest offset of all lanes including the padding
+struct _pfor_max_kernel
+{
+  template<std::size_t BitWidth, typename BackingStorage>
+  static auto run(const _pfor_block<BackingStorage>& block) -> std::int64_t
+  {
+    using T = multiple_int<BitWidth, BackingStorage>;
+
+    constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+    auto result = _multiple_int_access::make<T>(block.words[0]);
+
+    for (std::size_t w = 1; w * int_count < block.count; ++w)
+      result = max(result, _multiple_int_access::make<T>(block.words[w]));
+
+    return result.max();
+  }
+};
+
+// Sets bit i of bitmap iff lo <= value i <= hi for all lanes including the padding. bitmap is cleared and
+// needs room for ceil(count / 64) + 1 words.
+struct _pfor_scan_kernel
+{
+  template<std::size_t BitWidth, typename BackingStorage>
+  static void run(const _pfor_block<BackingStorage>& block, std::int64_t lo, std::int64_t hi, std::uint64_t* bitmap)
+  {
+    using T = multiple_int<BitWidth, BackingStorage>;
+
+    constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+    constexpr std::int64_t min_offset = -(std::int64_t {1} << (BitWidth - 1));
+    constexpr std::int64_t max_offset = (std::int64_t {1} << (BitWidth - 1)) - 1;
+
+    std::fill_n(bitmap, (block.count + 63) / 64 + 1, std::uint64_t {0});
+
+    const auto range = _frame_offset_range(block.base, lo, hi, min_offset, max_offset);
+
+    if (!range)
+      return;
+
+    for (std::size_t w = 0; w * int_count < block.count; ++w) {
+      const auto mask = _multiple_int_access::make<T>(block.words[w]).in_range((*range)[0], (*range)[1]);
+      const auto position = w * int_count;
+      const auto shift = position % 64;
+
+      bitmap[position / 64] |= mask << shift;
+
+      // The word straddles two bitmap words
+      if (shift + int_count > 64)
+        bitmap[position / 64 + 1] |= mask >> (64 - shift);
+    }
+  }
+};
+
+// Kernel instantiated for every BitWidth in _pfor_bit_widths, in the same order
+template<class Kernel, typename BackingStorage>
+inline constexpr auto _pfor_kernels = []<std::size_t... I>(std::index_sequence<I...>) constexpr
+{
+  return std::array {&Kernel::template run<_pfor_bit_widths<BackingStorage>[I], BackingStorage>...};
+}(std::make_index_sequence<_pfor_bit_widths<BackingStorage>.size()> {});
+}  // namespace detail
+
+// Patched frame-of-reference (PFOR) array of int64 values. Every block of BlockSize values picks the BitWidth
+// (one of bit_widths) that stores it in the fewest bits: the values from a window of 2^BitWidth values are
+// packed as offsets to the base of the block into multiple_int<BitWidth, BackingStorage>s, the few values
+// outside of it are stored as exceptions. So a rare outlier only costs its exception, while the typical
+// values keep the width they need. The algorithms run the kernel of the BitWidth of every block and patch
+// the exceptions in afterwards.
+/* clang-format off */
+template<std::unsigned_integral BackingStorage = std::uint64_t, std::size_t BlockSize = 128>
+requires(BlockSize > 0 && BlockSize % 64 == 0)
+class pfor_array
+/* clang-format on */
+{
+public:
+  static constexpr std::size_t block_size = BlockSize;
+
+  // The BitWidths the blocks pick from
+  static constexpr auto bit_widths = detail::_pfor_bit_widths<BackingStorage>;
+
+  // A value that does not fit into the window of its block, index is its position within the block
+  struct exception
+  {
+    std::uint32_t index;
+    std::int64_t value;
+  };
+
+private:
+  struct block_header
+  {
+    std::int64_t base;
+    std::int64_t placeholder;  // the value the lanes of the exceptions and the padding lanes decode to
+    std::uint32_t first_word;
+    std::uint32_t first_exception;
+    std::uint32_t exception_count;
+    std::uint8_t width_index;  // into bit_widths
+  };
+
+  static constexpr std::size_t storage_bits = 8 * sizeof(BackingStorage);
+  static constexpr std::size_t max_int_count = detail::_pfor_int_count<BackingStorage>(1);
+
+  std::size_t size_ = 0;
+  std::vector<block_header> blocks_;
+  std::vector<BackingStorage> words_;
+  std::vector<exception> exceptions_;
+
+public:
+  // Default ctor = empty array
+  pfor_array() = default;
+
+  static auto encode(std::span<const std::int64_t> values) -> pfor_array
+  {
+    pfor_array result {};
+
+    result.size_ = values.size();
+
+    for (std::size_t first = 0; first < values.size(); first += BlockSize)
+      result.append_block(values.subspan(first, std::min(BlockSize, values.size() - first)));
+
+    return result;
+  }
+
+  // Unpacks all values into out
+  auto decode(std::span<std::int64_t> out) const -> void
+  {
+    for (std::size_t block = 0; block < block_count(); ++block)
+      decode(block, out.subspan(block * BlockSize));
+  }
+
+  // Unpacks the values of block into out
+  auto decode(std::size_t block, std::span<std::int64_t> out) const -> void
+  {
+    run<detail::_pfor_decode_kernel>(block, view(block), out.data());
+
+    for (const auto& e : exceptions(block))
+      out[e.index] = e.value;
+  }
+
+  auto size() const -> std::size_t { return size_; }
+
+  auto block_count() const -> std::size_t { return blocks_.size(); }
+
+  // Number of values in block, only the last one may hold less than BlockSize
+  auto count(std::size_t block) const -> std::size_t { return std::min(BlockSize, size_ - block * BlockSize); }
+
+  auto bit_width(std::size_t block) const -> std::size_t { return bit_widths[blocks_[block].width_index]; }
+
+  auto exceptions(std::size_t block) const -> std::span<const exception>
+  {
+    return std::span {exceptions_}.subspan(blocks_[block].first_exception, blocks_[block].exception_count);
+  }
+
+  // The packed offsets of all blocks
+  auto words() const -> std::span<const BackingStorage> { return words_; }
+
+  // Returns the sum of the values of block, wrapping around like unsigned arithmetic if it exceeds the int64 range
+  auto sum(std::size_t block) const -> std::int64_t
+  {
+    const auto& header = blocks_[block];
+    const auto lanes = word_count(header.width_index, count(block)) * int_count(header.width_index);
+
+    // Every padding lane and every exception lane holds the placeholder, which is replaced by the exception
+    auto result = static_cast<std::uint64_t>(header.base) * lanes
+        + static_cast<std::uint64_t>(run<detail::_pfor_sum_kernel>(block, view(block)))
+        - static_cast<std::uint64_t>(header.placeholder) * (lanes - count(block));
+
+    for (const auto& e : exceptions(block))
+      result += static_cast<std::uint64_t>(e.value) - static_cast<std::uint64_t>(header.placeholder);
+
+    return static_cast<std::int64_t>(result);
+  }
+
+  // Returns the maximum of the values of block
+  auto max(std::size_t block) const -> std::int64_t
+  {
+    // The placeholder is one of the values, so the padding and exception lanes never raise the maximum
+    auto result = blocks_[block].base + run<detail::_pfor_max_kernel>(block, view(block));
+
+    for (const auto& e : exceptions(block))
+      result = std::max(result, e.value);
+
+    return result;
+  }
+
+  // Evaluates lo <= x <= hi for the values of block and writes the results as a bitmap (bit j of out[k] belongs to
+  // value 64 * k + j) into the first ceil(count(block) / 64) words of out
+  auto in_range(std::size_t block, std::int64_t lo, std::int64_t hi, std::span<std::uint64_t> out) const -> void
+  {
+    std::array<std::uint64_t, BlockSize / 64 + 1> bits;
+    run<detail::_pfor_scan_kernel>(block, view(block), lo, hi, bits.data());
+
+    for (const auto& e : exceptions(block)) {
+      const auto bit = std::uint64_t {1} << (e.index % 64);
+
+      bits[e.index / 64] = (bits[e.index / 64] & ~bit) | ((lo <= e.value && e.value <= hi) ? bit : 0);
+    }
+
+    const auto words = (count(block) + 63) / 64;
+
+    if (count(block) % 64 != 0)
+      bits[words - 1] &= (std::uint64_t {1} << (count(block) % 64)) - 1;
+
+    std::copy_n(bits.begin(), words, out.begin());
+  }
+
+private:
+  static constexpr auto int_count(std::size_t width_index) -> std::size_t
+  {
+    return detail::_pfor_int_count<BackingStorage>(bit_widths[width_index]);
+  }
+
+  static constexpr auto word_count(std::size_t width_index, std::size_t count) -> std::size_t
+  {
+    return (count + int_count(width_index) - 1) / int_count(width_index);
+  }
+
+  auto view(std::size_t block) const -> detail::_pfor_block<BackingStorage>
+  {
+    return {blocks_[block].base, words_.data() + blocks_[block].first_word, count(block)};
+  }
+
+  // Calls the Kernel for the BitWidth of block
+  template<class Kernel, class... Args>
+  auto run(std::size_t block, Args... args) const
+  {
+    return detail::_pfor_kernels<Kernel, BackingStorage>[blocks_[block].width_index](args...);
+  }
+
+  auto append_block(std::span<const std::int64_t> values) -> void
+  {
+    const auto n = values.size();
+
+    std::array<std::int64_t, BlockSize> sorted {};
+    std::copy(values.begin(), values.end(), sorted.begin());
+    std::sort(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(n));
+
+    // Every BitWidth gets the window covering the most values, the cheapest BitWidth wins
+    std::size_t width_index = 0;
+    std::int64_t window_lo = 0;
+    auto best_bits = std::numeric_limits<std::size_t>::max();
+
+    for (std::size_t k = 0; k < bit_widths.size(); ++k) {
+      const auto window = (std::uint64_t {1} << bit_widths[k]) - 1;
+
+      std::size_t covered = 0;
+      std::int64_t lo = 0;
+
+      for (std::size_t i = 0, j = 0; i < n; ++i) {
+        while (static_cast<std::uint64_t>(sorted[i]) - static_cast<std::uint64_t>(sorted[j]) > window)
+          ++j;
+
+        if (i - j + 1 > covered) {
+          covered = i - j + 1;
+          lo = sorted[j];
+        }
+      }
+
+      const auto bits = word_count(k, n) * storage_bits + (n - covered) * 8 * sizeof(exception);
+
+      if (bits < best_bits) {
+        best_bits = bits;
+        width_index = k;
+        window_lo = lo;
+      }
+
+      // A wider window cannot save any more exceptions
+      if (covered == n)
+        break;
+    }
+
+    const auto width = bit_widths[width_index];
+    const auto window = (std::uint64_t {1} << width) - 1;
+    const std::int64_t min_offset = -(std::int64_t {1} << (width - 1));
+    const std::int64_t max_offset = (std::int64_t {1} << (width - 1)) - 1;
+
+    block_header header {};
+    header.base = detail::_frame_base(window_lo, min_offset, max_offset);
+    header.placeholder = window_lo;
+    header.first_word = static_cast<std::uint32_t>(words_.size());
+    header.first_exception = static_cast<std::uint32_t>(exceptions_.size());
+    header.width_index = static_cast<std::uint8_t>(width_index);
+
+    const auto placeholder_offset = static_cast<int>(window_lo - header.base);
+
+    std::array<int, BlockSize + max_int_count> offsets;
+    offsets.fill(placeholder_offset);
+
+    for (std::size_t i = 0; i < n; ++i) {
+      const auto v = values[i];
+
+      if (v >= window_lo && static_cast<std::uint64_t>(v) - static_cast<std::uint64_t>(window_lo) <= window)
+        offsets[i] = static_cast<int>(v - header.base);
+      else
+        exceptions_.push_back({static_cast<std::uint32_t>(i), v});
+    }
+
+    header.exception_count = static_cast<std::uint32_t>(exceptions_.size() - header.first_exception);
+
+    words_.resize(words_.size() + word_count(width_index, n));
+    detail::_pfor_kernels<detail::_pfor_encode_kernel, BackingStorage>[width_index](
+        offsets.data(), n, words_.data() + header.first_word);
+
+    blocks_.push_back(header);
+  }
+};
+
+namespace detail
+{
+// Reduces init and f(block) for all blocks of array with op, the blocks are processed in parallel
+template<class Exec, class Array, typename T, class Op, class F>
+auto _transform_reduce_pfor_blocks(Exec&& exec, const Array& array, T init, Op op, F f) -> T
+{
+  std::vector<std::size_t> blocks(array.block_count());
+  std::iota(blocks.begin(), blocks.end(), std::size_t {0});
+
+  return std::transform_reduce(std::forward<Exec>(exec),
+                               blocks.begin(),
+                               blocks.end(),
+                               init,
+                               op,
+                               [&](std::size_t block) -> T { return f(block); });
+}
+}  // namespace detail
+
+// Returns the sum of all values, wrapping around like unsigned arithmetic if it exceeds the int64 range
+template<class Exec, typename BackingStorage, std::size_t BlockSize>
+auto sum_red(Exec&& exec, const pfor_array<BackingStorage, BlockSize>& array) -> std::int64_t
+{
+  return static_cast<std::int64_t>(
+      detail::_transform_reduce_pfor_blocks(std::forward<Exec>(exec),
+                                            array,
+                                            std::uint64_t {0},
+                                            std::plus<std::uint64_t>(),
+                                            [&](std::size_t block)
+                                            { return static_cast<std::uint64_t>(array.sum(block)); }));
+}
+
+// Returns the maximum of all values, the lowest int64 if there are none
+template<class Exec, typename BackingStorage, std::size_t BlockSize>
+auto max_red(Exec&& exec, const pfor_array<BackingStorage, BlockSize>& array) -> std::int64_t
+{
+  return detail::_transform_reduce_pfor_blocks(
+      std::forward<Exec>(exec),
+      array,
+      std::numeric_limits<std::int64_t>::lowest(),
+      [](std::int64_t x, std::int64_t y) { return std::max(x, y); },
+      [&](std::size_t block) { return array.max(block); });
+}
+
+// Evaluates lo <= x <= hi for every value and writes the results as a bitmap: bit j of out_bitmap[k] belongs
+// to the value with the index 64 * k + j. out_bitmap needs room for at least ceil(array.size() / 64) words.
+template<class Exec, typename BackingStorage, std::size_t BlockSize>
+void range_scan(Exec&& exec,
+                const pfor_array<BackingStorage, BlockSize>& array,
+                std::int64_t lo,
+                std::int64_t hi,
+                std::span<std::uint64_t> out_bitmap)
+{
+  std::vector<std::size_t> blocks(array.block_count());
+  std::iota(blocks.begin(), blocks.end(), std::size_t {0});
+
+  std::for_each(std::forward<Exec>(exec),
+                blocks.begin(),
+                blocks.end(),
+                [&](std::size_t block)
+                { array.in_range(block, lo, hi, out_bitmap.subspan(block * (BlockSize / 64))); });
+}
+}  // namespace multipleint
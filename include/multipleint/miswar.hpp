@@ -0,0 +1,626 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "mitraits.hpp"
+
+namespace multipleint::detail
+{
+
+// Word with elements of twice the size: the next widest integer for a single word, a vector of as many
+// elements of the next widest integer for a vector of words
+template<class Word, typename BackingStorage>
+struct _widened_word;
+
+template<std::unsigned_integral Word, typename BackingStorage>
+struct _widened_word<Word, BackingStorage>
+{
+  using type = typename _next_widest<Word>::type;
+};
+
+// The inverse of _widened_word: a word or vector with elements of half the size
+template<class WideWord, typename BackingStorage>
+struct _narrowed_word;
+
+template<std::unsigned_integral WideWord, typename BackingStorage>
+struct _narrowed_word<WideWord, BackingStorage>
+{
+  using type = BackingStorage;
+};
+
+// Converts every element of word to the element type of To, which has as many elements
+template<class To, std::integral Word>
+constexpr auto _convert_elements(Word word) -> To
+{
+  return static_cast<To>(word);
+}
+
+// The lane arithmetic of _swar on vectors of words whose lanes fill exactly one 8, 16 or 32-bit element each,
+// see _swar::native_lanes
+template<std::size_t BitWidth, class Traits>
+struct _native_lane_arithmetic;
+
+// Vectors of words need the vector extensions of GCC and Clang (see multiple_int_batch), single words work
+// with any compiler
+#if defined(__GNUC__)
+
+// Word reinterpreted as a vector of LaneBits-bit unsigned and signed elements
+template<class Word, std::size_t LaneBits>
+struct _lane_vector;
+
+template<class Word>
+struct _lane_vector<Word, 8>
+{
+  typedef std::uint8_t unsigned_type __attribute__((vector_size(sizeof(Word))));
+  typedef std::int8_t signed_type __attribute__((vector_size(sizeof(Word))));
+};
+
+template<class Word>
+struct _lane_vector<Word, 16>
+{
+  typedef std::uint16_t unsigned_type __attribute__((vector_size(sizeof(Word))));
+  typedef std::int16_t signed_type __attribute__((vector_size(sizeof(Word))));
+};
+
+template<class Word>
+struct _lane_vector<Word, 32>
+{
+  typedef std::uint32_t unsigned_type __attribute__((vector_size(sizeof(Word))));
+  typedef std::int32_t signed_type __attribute__((vector_size(sizeof(Word))));
+};
+
+// WordCount words of BackingStorage in a vector, the words of multiple_int_batch. GCC warns (-Wpsabi) about
+// functions that pass or return vectors wider than the registers of the enabled instruction set, as their ABI
+// depends on it. The lane arithmetic therefore takes its words by reference and returns vectors in this struct.
+template<typename BackingStorage, std::size_t WordCount>
+struct _word_vector
+{
+  typedef BackingStorage vector_type __attribute__((vector_size(WordCount * sizeof(BackingStorage))));
+
+  vector_type elements;
+
+  friend constexpr auto operator~(const _word_vector& value) -> _word_vector { return {~value.elements}; }
+
+  friend constexpr auto operator<<(const _word_vector& value, std::size_t shift) -> _word_vector
+  {
+    return {value.elements << shift};
+  }
+
+  friend constexpr auto operator>>(const _word_vector& value, std::size_t shift) -> _word_vector
+  {
+    return {value.elements >> shift};
+  }
+
+  // The binary operators take a single word on either side as well, like the vectors themselves
+
+  template<class Lhs, class Rhs>
+  requires(std::same_as<Lhs, _word_vector> || std::same_as<Rhs, _word_vector>)
+  friend constexpr auto operator+(const Lhs& lhs, const Rhs& rhs) -> _word_vector
+  {
+    return {elements_of(lhs) + elements_of(rhs)};
+  }
+
+  template<class Lhs, class Rhs>
+  requires(std::same_as<Lhs, _word_vector> || std::same_as<Rhs, _word_vector>)
+  friend constexpr auto operator-(const Lhs& lhs, const Rhs& rhs) -> _word_vector
+  {
+    return {elements_of(lhs) - elements_of(rhs)};
+  }
+
+  template<class Lhs, class Rhs>
+  requires(std::same_as<Lhs, _word_vector> || std::same_as<Rhs, _word_vector>)
+  friend constexpr auto operator&(const Lhs& lhs, const Rhs& rhs) -> _word_vector
+  {
+    return {elements_of(lhs) & elements_of(rhs)};
+  }
+
+  template<class Lhs, class Rhs>
+  requires(std::same_as<Lhs, _word_vector> || std::same_as<Rhs, _word_vector>)
+  friend constexpr auto operator|(const Lhs& lhs, const Rhs& rhs) -> _word_vector
+  {
+    return {elements_of(lhs) | elements_of(rhs)};
+  }
+
+  template<class Lhs, class Rhs>
+  requires(std::same_as<Lhs, _word_vector> || std::same_as<Rhs, _word_vector>)
+  friend constexpr auto operator^(const Lhs& lhs, const Rhs& rhs) -> _word_vector
+  {
+    return {elements_of(lhs) ^ elements_of(rhs)};
+  }
+
+private:
+  static constexpr auto elements_of(const _word_vector& value) -> const vector_type& { return value.elements; }
+
+  static constexpr auto elements_of(const BackingStorage& word) -> const BackingStorage& { return word; }
+};
+
+template<typename Storage, std::size_t WordCount, typename BackingStorage>
+struct _widened_word<_word_vector<Storage, WordCount>, BackingStorage>
+{
+  using type = _word_vector<typename _next_widest<Storage>::type, WordCount>;
+};
+
+template<typename WideStorage, std::size_t WordCount, typename BackingStorage>
+struct _narrowed_word<_word_vector<WideStorage, WordCount>, BackingStorage>
+{
+  using type = _word_vector<BackingStorage, WordCount>;
+};
+
+template<class To, typename Storage, std::size_t WordCount>
+constexpr auto _convert_elements(const _word_vector<Storage, WordCount>& word) -> To
+{
+  return {__builtin_convertvector(word.elements, typename To::vector_type)};
+}
+
+// The native versions double every element first, which drops the carry bit and moves the sign of the value
+// into the sign bit of the element. The element arithmetic then overflows exactly when the lane arithmetic
+// does, and halving the result gives the new value.
+template<std::size_t BitWidth, class Traits>
+struct _native_lane_arithmetic
+{
+  using traits = Traits;
+
+  template<class Word>
+  static constexpr auto add(const Word& lhs, const Word& rhs) -> Word
+  {
+    using lanes = unsigned_lanes<Word>;
+
+    constexpr auto carry_bit = traits::carry_mask & traits::lane_mask;
+
+    const auto a = __builtin_bit_cast(lanes, lhs);
+    const auto b = __builtin_bit_cast(lanes, rhs);
+
+    const lanes a2 = a + a;
+    const lanes b2 = b + b;
+    const lanes sum = a2 + b2;
+
+    const lanes error = (a2 ^ sum) & (b2 ^ sum) & carry_bit;
+
+    return __builtin_bit_cast(Word, (sum >> 1) | error | ((a | b) & carry_bit));
+  }
+
+  template<class Word>
+  static constexpr auto subtract(const Word& lhs, const Word& rhs) -> Word
+  {
+    using lanes = unsigned_lanes<Word>;
+
+    constexpr auto carry_bit = traits::carry_mask & traits::lane_mask;
+
+    const auto a = __builtin_bit_cast(lanes, lhs);
+    const auto b = __builtin_bit_cast(lanes, rhs);
+
+    const lanes a2 = a + a;
+    const lanes b2 = b + b;
+    const lanes difference = a2 - b2;
+
+    // Like subtract, which adds the negated rhs, no overflow is reported for subtracting the minimum
+    const auto rhs_is_min = __builtin_bit_cast(lanes, b2 == carry_bit);
+    const lanes error = (a2 ^ b2) & (a2 ^ difference) & carry_bit & ~rhs_is_min;
+
+    return __builtin_bit_cast(Word, (difference >> 1) | error | ((a | b) & carry_bit));
+  }
+
+  template<class Word>
+  static constexpr auto negate(const Word& value) -> Word
+  {
+    using lanes = unsigned_lanes<Word>;
+
+    constexpr auto carry_bit = traits::carry_mask & traits::lane_mask;
+
+    const auto a = __builtin_bit_cast(lanes, value);
+
+    const lanes a2 = a + a;
+    const lanes negated = -a2;
+
+    // Only the minimum is negative before and after the negation
+    const lanes error = a2 & negated & carry_bit;
+
+    return __builtin_bit_cast(Word, (negated >> 1) | error | (a & carry_bit));
+  }
+
+  template<class Word>
+  static constexpr auto max(const Word& lhs, const Word& rhs) -> Word
+  {
+    using lanes = unsigned_lanes<Word>;
+
+    const auto a = __builtin_bit_cast(lanes, lhs);
+    const auto b = __builtin_bit_cast(lanes, rhs);
+
+    const auto a2 = __builtin_bit_cast(signed_lanes<Word>, static_cast<lanes>(a + a));
+    const auto b2 = __builtin_bit_cast(signed_lanes<Word>, static_cast<lanes>(b + b));
+
+    const auto max_mask = __builtin_bit_cast(lanes, a2 >= b2);
+
+    return __builtin_bit_cast(Word, (a & max_mask) | (b & ~max_mask));
+  }
+
+private:
+  template<class Word>
+  using unsigned_lanes = typename _lane_vector<Word, BitWidth + 1>::unsigned_type;
+
+  template<class Word>
+  using signed_lanes = typename _lane_vector<Word, BitWidth + 1>::signed_type;
+};
+
+#endif
+
+// The portable lane arithmetic on raw words for any layout of lanes, Traits gives the masks of the layout and
+// moves the sign bits to the lowest bits of their lanes (see _multiple_int_traits). Word is either
+// BackingStorage itself or a _word_vector of BackingStorage words (see multiple_int_batch), so both share exactly
+// the same carry semantics.
+template<class Traits, typename BackingStorage>
+struct _swar_arithmetic
+{
+  using traits = Traits;
+
+  template<class Word>
+  static constexpr auto intv(const Word& value) -> Word
+  {
+    return static_cast<Word>(value & traits::int_mask);
+  }
+
+  template<class Word>
+  static constexpr auto carry(const Word& value) -> Word
+  {
+    return static_cast<Word>(value & traits::carry_mask);
+  }
+
+  template<class Word>
+  static constexpr auto add(const Word& lhs, const Word& rhs) -> Word
+  {
+    // Use intv instead of the raw value to avoid adding carry bits, which
+    // would "bleed" their overflow into the LSB of the following integer
+    const auto lhsi = intv(lhs);
+    const auto rhsi = intv(rhs);
+    auto sumi = static_cast<Word>(lhsi + rhsi);
+
+    const auto lhs_signs = static_cast<Word>(lhsi & traits::sign_mask);
+    const auto rhs_signs = static_cast<Word>(rhsi & traits::sign_mask);
+    const auto sum_signs = static_cast<Word>(sumi & traits::sign_mask);
+
+    const auto error = static_cast<Word>((lhs_signs ^ sum_signs) & (rhs_signs ^ sum_signs));
+
+    // zero out carry bits, replace with calculated carry bits
+    sumi = intv(sumi);
+    sumi = static_cast<Word>(sumi | (error << 1) | carry(lhs) | carry(rhs));
+
+    return sumi;
+  }
+
+  template<class Word>
+  static constexpr auto negate(const Word& value) -> Word
+  {
+    constexpr auto add_one_mask = static_cast<BackingStorage>((traits::carry_mask << 1) | 1) & ~traits::empty_mask;
+
+    const auto tint = intv(value);
+    const auto negated = static_cast<Word>(~tint);
+
+    // apply and twice to avoid carry bits when handling 0
+    const auto un_minus_wcarry = static_cast<Word>(intv(negated) + static_cast<BackingStorage>(add_one_mask));
+
+    const auto no_sign_change = static_cast<Word>((~(tint ^ un_minus_wcarry) & traits::sign_mask) << 1);
+    const auto errors = static_cast<Word>(no_sign_change ^ carry(un_minus_wcarry));
+
+    const auto un_minus = intv(un_minus_wcarry);
+
+    return static_cast<Word>(un_minus | errors | carry(value));
+  }
+
+  template<class Word>
+  static constexpr auto subtract(const Word& lhs, const Word& rhs) -> Word
+  {
+    // Carry bit that only occur when attempting to negate the min.
+    const auto inv_rhs = negate(rhs);
+    const auto inv_carries = carry(static_cast<Word>(carry(inv_rhs) - carry(rhs)));
+
+    auto orig_sum = add(lhs, inv_rhs);
+
+    // turn off bits that were set due to negation error
+    orig_sum = static_cast<Word>(orig_sum & ~inv_carries);
+
+    // turn on if they were set anyway in the original rhs and rhs
+    return static_cast<Word>(orig_sum | carry(lhs) | carry(rhs));
+  }
+
+  // Lanes in which lhs >= rhs are filled with 1s (including the carry bit), all others with 0s
+  template<class Word>
+  static constexpr auto max_select_mask(const Word& lhs, const Word& rhs) -> Word
+  {
+    const auto diffA = add(intv(lhs), negate(intv(rhs)));
+    const auto diffB = add(intv(rhs), negate(intv(lhs)));
+
+    // Extract the carry bits and shift it to the sign position
+    const auto carries_at_signA = static_cast<Word>(carry(diffA) >> 1);
+    const auto carries_at_signB = static_cast<Word>(carry(diffB) >> 1);
+
+    const auto signs = traits::signs_to_lowest_bits(static_cast<Word>(
+        ((diffA & traits::sign_mask) & ~carries_at_signA) | ((diffB & traits::sign_mask) & carries_at_signB)));
+
+    // Generate blocks of 0s or 1s depeding on the sign bit
+    auto max_mask = intv(static_cast<Word>(signs + traits::int_mask));
+    max_mask = static_cast<Word>(max_mask | ((max_mask & traits::sign_mask) << 1));
+
+    return max_mask;
+  }
+
+  template<class Word>
+  static constexpr auto max(const Word& lhs, const Word& rhs) -> Word
+  {
+    const auto max_mask = max_select_mask(lhs, rhs);
+
+    // Select the max value with max_mask
+    return static_cast<Word>((lhs & max_mask) | (rhs & ~max_mask));
+  }
+};
+
+// The lane arithmetic of multiple_int on raw words, see _swar_arithmetic
+template<std::size_t BitWidth, typename BackingStorage>
+struct _swar
+    : _swar_arithmetic<_multiple_int_traits<(8 * sizeof(BackingStorage)) / (BitWidth + 1), BitWidth, BackingStorage>,
+                       BackingStorage>
+{
+  static constexpr int IntCount = (8 * sizeof(BackingStorage)) / (BitWidth + 1);
+
+  using portable =
+      _swar_arithmetic<_multiple_int_traits<(8 * sizeof(BackingStorage)) / (BitWidth + 1), BitWidth, BackingStorage>,
+                       BackingStorage>;
+
+  using traits = typename portable::traits;
+
+  using native = _native_lane_arithmetic<BitWidth, traits>;
+
+  using portable::carry;
+  using portable::intv;
+  using portable::max_select_mask;
+
+  // Every lane and its carry bit fill exactly one 8, 16 or 32-bit element, so vectors of words can use the
+  // packed element instructions (paddb, psubw, pcmpgtd, ...) instead of masking. Single words stay with the
+  // general-purpose registers.
+  template<class Word>
+  static constexpr bool native_lanes =
+      !std::is_integral_v<Word> && (BitWidth + 1 == 8 || BitWidth + 1 == 16 || BitWidth + 1 == 32);
+
+  template<class Word>
+  static constexpr auto add(const Word& lhs, const Word& rhs) -> Word
+  {
+    if constexpr (native_lanes<Word>)
+      return native::add(lhs, rhs);
+    else
+      return portable::add(lhs, rhs);
+  }
+
+  template<class Word>
+  static constexpr auto negate(const Word& value) -> Word
+  {
+    if constexpr (native_lanes<Word>)
+      return native::negate(value);
+    else
+      return portable::negate(value);
+  }
+
+  template<class Word>
+  static constexpr auto subtract(const Word& lhs, const Word& rhs) -> Word
+  {
+    if constexpr (native_lanes<Word>)
+      return native::subtract(lhs, rhs);
+    else
+      return portable::subtract(lhs, rhs);
+  }
+
+  template<class Word>
+  static constexpr auto max(const Word& lhs, const Word& rhs) -> Word
+  {
+    if constexpr (native_lanes<Word>)
+      return native::max(lhs, rhs);
+    else
+      return portable::max(lhs, rhs);
+  }
+
+  // The lanes of value sign-extended to 2 * BitWidth + 1 bits in a word of twice the size, lane k of value
+  // becomes lane k of the result (the upcasting constructor of multiple_int interleaves them instead). The
+  // carry bits are cleared.
+  template<class Word>
+  static constexpr auto widen(const Word& value) -> typename _widened_word<Word, BackingStorage>::type
+  {
+    using wide_word = typename _widened_word<Word, BackingStorage>::type;
+    using wide_storage = typename _next_widest<BackingStorage>::type;
+
+    static_assert(sizeof(wide_storage) == 2 * sizeof(BackingStorage), "there is no wider BackingStorage");
+
+    const auto wide = _convert_elements<wide_word>(intv(value));
+
+    constexpr auto lanes = static_cast<std::size_t>(IntCount);
+
+    return sign_extend<wide_storage, lanes>(spread<wide_storage, lanes, spread_start(lanes)>(wide));
+  }
+
+  // The lowest IntCount / 2 lanes of value (Half = 0) or the highest ones (Half = 1) sign-extended to
+  // 2 * BitWidth + 1 bits in a word of the same size, lane k of the half becomes lane k of the result like for
+  // widen. The carry bits are cleared.
+  template<std::size_t Half, class Word>
+  static constexpr auto unpack(const Word& value) -> Word
+  {
+    constexpr std::size_t lanes = IntCount / 2;
+
+    constexpr auto values = _lane_pattern<lanes, BitWidth, BackingStorage>(
+        static_cast<BackingStorage>((BackingStorage {1} << BitWidth) - 1));
+
+    const auto half = static_cast<Word>(static_cast<Word>(value >> (Half * lanes * (BitWidth + 1))) & values);
+
+    return sign_extend<BackingStorage, lanes>(spread<BackingStorage, lanes, spread_start(lanes)>(half));
+  }
+
+  // The inverse of unpack: the lowest BitWidth bits of the lanes of lo and hi become the lower and the upper
+  // half of the lanes of the result, the higher bits and the carry bits are dropped
+  template<class Word>
+  static constexpr auto pack(const Word& lo, const Word& hi) -> Word
+  {
+    constexpr std::size_t lanes = IntCount / 2;
+
+    constexpr auto values = _lane_pattern<lanes, 2 * BitWidth + 1, BackingStorage>(
+        static_cast<BackingStorage>((BackingStorage {1} << BitWidth) - 1));
+
+    const auto lower = compress<BackingStorage, lanes, 1>(static_cast<Word>(lo & values));
+    const auto upper = compress<BackingStorage, lanes, 1>(static_cast<Word>(hi & values));
+
+    return static_cast<Word>(lower | static_cast<Word>(upper << (lanes * (BitWidth + 1))));
+  }
+
+  // Lanes of a widened word (see widen) whose integer does not fit into BitWidth bits are set to 1, all others
+  // to 0. The carry bits are ignored.
+  template<class WideWord>
+  static constexpr auto out_of_range(const WideWord& wide) -> WideWord
+  {
+    using wide_storage = typename _next_widest<BackingStorage>::type;
+
+    // The integer fits if bits BitWidth - 1 to 2 * BitWidth of its lane are equal, adding 1 to them gives either
+    // 0 or 1 then. Any other sum has one of the bits 1 to BitWidth + 1 set, which then carry into bit
+    // BitWidth + 2 when 2^(BitWidth + 2) - 2 is added.
+    constexpr auto field_bits = static_cast<wide_storage>((wide_storage {1} << (BitWidth + 2)) - 1);
+
+    constexpr auto fields = _lane_pattern<IntCount, 2 * BitWidth + 1, wide_storage>(field_bits);
+    constexpr auto ones = _lane_pattern<IntCount, 2 * BitWidth + 1, wide_storage>(1);
+    constexpr auto unequal = _lane_pattern<IntCount, 2 * BitWidth + 1, wide_storage>(field_bits & ~wide_storage {1});
+
+    const auto sums = static_cast<WideWord>(static_cast<WideWord>((wide >> (BitWidth - 1)) & fields) + ones);
+    const auto differences = static_cast<WideWord>(sums & unequal);
+
+    return static_cast<WideWord>(static_cast<WideWord>((differences + unequal) >> (BitWidth + 2)) & ones);
+  }
+
+  // Replaces the integers of a widened word in the lanes set to 1 in lanes (see out_of_range) by the smallest
+  // integer of BitWidth bits if they are negative and by the largest one otherwise
+  template<class WideWord>
+  static constexpr auto saturate(const WideWord& wide, const WideWord& lanes) -> WideWord
+  {
+    using wide_storage = typename _next_widest<BackingStorage>::type;
+
+    constexpr auto lane_bits = 2 * BitWidth + 2;
+    constexpr auto largest = static_cast<wide_storage>((wide_storage {1} << (BitWidth - 1)) - 1);
+
+    constexpr auto largest_lanes = _lane_pattern<IntCount, 2 * BitWidth + 1, wide_storage>(largest);
+    constexpr auto smallest_lanes = _lane_pattern<IntCount, 2 * BitWidth + 1, wide_storage>(
+        static_cast<wide_storage>(((wide_storage {1} << (2 * BitWidth + 1)) - 1) & ~largest));
+
+    // Every bit of the lanes with their lowest bit set in ones: the bits below the top bit of each lane come from
+    // subtracting 1, which never borrows from the lane above
+    const auto fill = [](const WideWord& ones) constexpr
+    {
+      const auto top = static_cast<WideWord>(ones << (lane_bits - 1));
+
+      return static_cast<WideWord>(static_cast<WideWord>(top - ones) | top);
+    };
+
+    const auto selected_bits = fill(lanes);
+    const auto negative_bits = fill(static_cast<WideWord>((wide >> (2 * BitWidth)) & lanes));
+
+    const auto saturated =
+        static_cast<WideWord>((largest_lanes & ~negative_bits) | (smallest_lanes & negative_bits));
+
+    return static_cast<WideWord>((wide & ~selected_bits) | (saturated & selected_bits));
+  }
+
+  // The inverse of widen: the lowest BitWidth bits of lane k of a widened word become lane k of the result,
+  // the higher bits and the carry bits are dropped
+  template<class WideWord>
+  static constexpr auto narrow(const WideWord& wide) -> typename _narrowed_word<WideWord, BackingStorage>::type
+  {
+    using word = typename _narrowed_word<WideWord, BackingStorage>::type;
+    using wide_storage = typename _next_widest<BackingStorage>::type;
+
+    constexpr auto values = _lane_pattern<IntCount, 2 * BitWidth + 1, wide_storage>(
+        static_cast<wide_storage>((wide_storage {1} << BitWidth) - 1));
+
+    constexpr auto lanes = static_cast<std::size_t>(IntCount);
+
+    const auto compressed = compress<wide_storage, lanes, 1>(static_cast<WideWord>(wide & values));
+
+    return _convert_elements<word>(compressed);
+  }
+
+private:
+  // The first Step of spread for Lanes lanes: the highest bit of the largest lane index
+  static constexpr auto spread_start(std::size_t lanes) -> std::size_t
+  {
+    return lanes == 0 ? 0 : std::bit_floor(lanes - 1);
+  }
+
+  // Moves every lane k with (k & Step) != 0 of the lowest Lanes lanes of a wide word up by Step lanes, then
+  // continues with the next lower bit of k. As the lanes with the highest bits move first, no lane ever
+  // overlaps another one, and lane k finally starts at bit k * (2 * BitWidth + 2) (like the spreading of the
+  // bits of Morton codes).
+  template<typename WideStorage, std::size_t Lanes, std::size_t Step, class Word>
+  static constexpr auto spread(const Word& value) -> Word
+  {
+    if constexpr (Step == 0) {
+      return value;
+    } else {
+      constexpr auto moving = []() consteval
+      {
+        constexpr auto lane = static_cast<WideStorage>((WideStorage {1} << BitWidth) - 1);
+
+        WideStorage mask = 0;
+
+        for (std::size_t k = Step; k < Lanes; ++k) {
+          if ((k & Step) != 0)
+            mask |= static_cast<WideStorage>(lane << ((k + (k & ~(2 * Step - 1))) * (BitWidth + 1)));
+        }
+
+        return mask;
+      }();
+
+      const auto moved = static_cast<Word>((value & static_cast<WideStorage>(~moving))
+                                           | static_cast<Word>((value & moving) << (Step * (BitWidth + 1))));
+
+      return spread<WideStorage, Lanes, Step / 2>(moved);
+    }
+  }
+
+  // The inverse of spread: moves every lane k with (k & Step) != 0 of a wide word down by Step lanes, then
+  // continues with the next higher bit of k, so lane k finally starts at bit k * (BitWidth + 1)
+  template<typename WideStorage, std::size_t Lanes, std::size_t Step, class Word>
+  static constexpr auto compress(const Word& value) -> Word
+  {
+    if constexpr (Step >= Lanes) {
+      return value;
+    } else {
+      constexpr auto moving = []() consteval
+      {
+        constexpr auto lane = static_cast<WideStorage>((WideStorage {1} << BitWidth) - 1);
+
+        WideStorage mask = 0;
+
+        for (std::size_t k = Step; k < Lanes; ++k) {
+          if ((k & Step) != 0)
+            mask |= static_cast<WideStorage>(lane << ((k + (k & ~(Step - 1))) * (BitWidth + 1)));
+        }
+
+        return mask;
+      }();
+
+      const auto moved = static_cast<Word>((value & static_cast<WideStorage>(~moving))
+                                           | static_cast<Word>((value & moving) >> (Step * (BitWidth + 1))));
+
+      return compress<WideStorage, Lanes, 2 * Step>(moved);
+    }
+  }
+
+  // Copies the sign bit of the lowest Lanes lanes of a spread word into the bits BitWidth to 2 * BitWidth of
+  // their wide lanes
+  template<typename WideStorage, std::size_t Lanes, class Word>
+  static constexpr auto sign_extend(const Word& value) -> Word
+  {
+    constexpr auto signs = _lane_pattern<Lanes, 2 * BitWidth + 1, WideStorage>(
+        static_cast<WideStorage>(WideStorage {1} << (BitWidth - 1)));
+
+    const auto sign_bits = static_cast<Word>(value & signs);
+
+    return static_cast<Word>(value | static_cast<Word>((sign_bits << (BitWidth + 2)) - (sign_bits << 1)));
+  }
+};
+
+}  // namespace multipleint::detail
@@ -103,6 +103,33 @@ struct sign_mask<0, BitWidth, BackingStorage>
 template<std::size_t IntCount, std::size_t BitWidth, typename BackingStorage>
 static constexpr auto _sign_mask_v = sign_mask<IntCount, BitWidth, BackingStorage>::value;
 
+// Place Pattern at the start of every (BitWidth + 1)-bit lane with an index in [First, IntCount) and a
+// distance of Step lanes between two patterns
+template<std::size_t IntCount, std::size_t BitWidth, typename BackingStorage>
+consteval auto _lane_pattern(BackingStorage pattern, std::size_t first = 0, std::size_t step = 1) -> BackingStorage
+{
+  BackingStorage value = 0;
+
+  for (std::size_t i = first; i < IntCount; i += step)
+    value |= static_cast<BackingStorage>(pattern << (i * (BitWidth + 1)));
+
+  return value;
+}
+
+// Place Pattern at the start of every (BitWidth + 1)-bit lane whose bit is set in Lanes
+template<std::size_t IntCount, std::size_t BitWidth, typename BackingStorage>
+consteval auto _lane_select(std::uint64_t lanes, BackingStorage pattern) -> BackingStorage
+{
+  BackingStorage value = 0;
+
+  for (std::size_t i = 0; i < IntCount; ++i) {
+    if ((lanes >> i) & 1)
+      value |= static_cast<BackingStorage>(pattern << (i * (BitWidth + 1)));
+  }
+
+  return value;
+}
+
 // Next widest uint_t-datatype
 template<class>
 struct _next_widest;
@@ -192,6 +219,18 @@ struct _multiple_int_traits
 
   static constexpr BackingStorage sign_mask = _sign_mask_v<IntCount, BitWidth, BackingStorage>;
 
+  // Masks the value and the carry bit of the lowest integer
+  static constexpr BackingStorage lane_mask =
+      _int_mask_v<1, BitWidth, BackingStorage> | _carry_mask_v<1, BitWidth, BackingStorage>;
+
+  // Moves the sign bits (and nothing else) to the lowest bits of their lanes. Word may be a vector of words
+  // (see miswar.hpp).
+  template<class Word>
+  static constexpr auto signs_to_lowest_bits(const Word& signs) -> Word
+  {
+    return static_cast<Word>(signs >> (BitWidth - 1));
+  }
+
   template<typename T>
   using next_widest = typename _next_widest<T>::type;
 };
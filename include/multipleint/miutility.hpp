@@ -1,7 +1,14 @@
 #pragma once
 
+#include <array>
+#include <bit>
+#include <cstdint>
 #include <type_traits>
 
+#if defined(__BMI2__) && defined(__x86_64__)
+#  include <immintrin.h>
+#endif
+
 namespace multipleint::detail
 {
 template<class IndexSequence, std::size_t Add>
@@ -30,4 +37,147 @@ constexpr auto array_repeat(T x) -> std::array<T, N>
     return std::array<T, N> {identity.template operator()<Idx>()...};
   }(std::make_index_sequence<N>());
 }
+
+struct _compare_exchange_round
+{
+  // Compare (and swap if out of order) element i with element i + distance for every bit i set in lanes
+  std::size_t distance;
+  std::uint64_t lanes;
+};
+
+// Rounds of Batcher's merge exchange sort (Knuth, TAOCP Vol. 3, Algorithm 5.2.2M) for N <= 64 elements.
+// All comparisons of a round share the same distance, so a round can be applied to all elements at once.
+template<std::size_t N>
+requires(N > 0 && N <= 64)
+consteval auto merge_exchange_network()
+{
+  constexpr auto t = static_cast<std::size_t>(std::bit_width(N - 1));
+
+  std::array<_compare_exchange_round, t*(t + 1) / 2> rounds {};
+  std::size_t round = 0;
+
+  if constexpr (t > 0) {
+    for (std::size_t p = std::size_t {1} << (t - 1); p > 0; p /= 2) {
+      std::size_t q = std::size_t {1} << (t - 1);
+      std::size_t r = 0;
+      std::size_t d = p;
+
+      while (true) {
+        std::uint64_t lanes = 0;
+
+        for (std::size_t i = 0; i + d < N; ++i) {
+          if ((i & p) == r)
+            lanes |= std::uint64_t {1} << i;
+        }
+
+        rounds[round++] = {d, lanes};
+
+        if (q == p)
+          break;
+
+        d = q - p;
+        q /= 2;
+        r = p;
+      }
+    }
+  }
+
+  return rounds;
+}
+
+template<std::size_t N>
+inline constexpr auto merge_exchange_network_v = merge_exchange_network<N>();
+
+// Source lanes of a permutation (destination lane j receives source lane Idx[j]) grouped by the distance
+// they have to be moved. Entry k holds a bit for every source lane that moves by k - (N - 1) lanes.
+template<std::size_t... Idx>
+consteval auto lane_moves() -> std::array<std::uint64_t, 2 * sizeof...(Idx) - 1>
+{
+  constexpr std::size_t n = sizeof...(Idx);
+  constexpr std::array<std::size_t, n> idx {Idx...};
+
+  std::array<std::uint64_t, 2 * n - 1> moves {};
+
+  for (std::size_t j = 0; j < n; ++j)
+    moves[j + n - 1 - idx[j]] |= std::uint64_t {1} << idx[j];
+
+  return moves;
+}
+
+template<std::size_t... Idx>
+inline constexpr auto lane_moves_v = lane_moves<Idx...>();
+
+// Gathers the lowest bit of every (BitWidth + 1)-bit lane into the lowest IntCount bits
+template<std::size_t IntCount, std::size_t BitWidth, typename BackingStorage>
+constexpr auto compress_lanes(BackingStorage lanes) -> std::uint64_t
+{
+  using wide_type = std::common_type_t<BackingStorage, unsigned int>;
+
+  if constexpr (IntCount <= BitWidth) {
+    // Lane i is multiplied into bit (IntCount - 1) * BitWidth + i. As long as there are at most BitWidth
+    // lanes no two partial products hit the same bit, so there are no carries either.
+    constexpr auto magic = []() consteval
+    {
+      wide_type m = 0;
+
+      for (std::size_t j = 0; j < IntCount; ++j)
+        m |= static_cast<wide_type>(static_cast<wide_type>(1) << (j * BitWidth));
+
+      return m;
+    }();
+
+    constexpr auto mask = (std::uint64_t {1} << IntCount) - 1;
+
+    return (static_cast<std::uint64_t>(static_cast<BackingStorage>(static_cast<wide_type>(lanes) * magic))
+            >> ((IntCount - 1) * BitWidth))
+        & mask;
+  } else {
+    return [lanes]<std::size_t... Idx>(std::index_sequence<Idx...>) constexpr
+    {
+      return ((static_cast<std::uint64_t>((lanes >> (Idx * (BitWidth + 1))) & 1) << Idx) | ...);
+    }(std::make_index_sequence<IntCount> {});
+  }
+}
+
+// Places bit i of bits into the lowest bit of the (BitWidth + 1)-bit lane i
+template<std::size_t IntCount, std::size_t BitWidth, typename BackingStorage>
+constexpr auto expand_lanes(std::uint64_t bits) -> BackingStorage
+{
+  return [bits]<std::size_t... Idx>(std::index_sequence<Idx...>) constexpr
+  {
+    return static_cast<BackingStorage>(
+        ((static_cast<BackingStorage>((bits >> Idx) & 1) << (Idx * (BitWidth + 1))) | ...));
+  }(std::make_index_sequence<IntCount> {});
+}
+
+// Gathers the bits of x selected by mask into the lowest bits (like pext)
+constexpr auto compress_bits(std::uint64_t x, std::uint64_t mask) -> std::uint64_t
+{
+#if defined(__BMI2__) && defined(__x86_64__)
+  if (!std::is_constant_evaluated())
+    return _pext_u64(x, mask);
+#endif
+
+  // Hacker's Delight, 2nd edition, Section 7-4: every bit moves right by the number of unselected bits
+  // below it, which is done in 6 steps of 2^i bits each
+  x &= mask;
+  std::uint64_t zeros = ~mask << 1;
+
+  for (std::size_t i = 0; i < 6; ++i) {
+    std::uint64_t prefix = zeros ^ (zeros << 1);
+
+    for (std::size_t shift = 2; shift < 64; shift *= 2)
+      prefix ^= prefix << shift;
+
+    const auto moving = prefix & mask;
+    mask = (mask ^ moving) | (moving >> (std::size_t {1} << i));
+
+    const auto bits = x & moving;
+    x = (x ^ bits) | (bits >> (std::size_t {1} << i));
+
+    zeros &= ~prefix;
+  }
+
+  return x;
+}
 }  // namespace multipleint::detail
\ No newline at end of file
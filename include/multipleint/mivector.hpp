@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "mi.hpp"
+
+namespace multipleint
+{
+
+namespace detail
+{
+// The integer in lane of word, the lane is only known at runtime
+template<std::size_t BitWidth, typename BackingStorage>
+constexpr auto _get_lane(multiple_int<BitWidth, BackingStorage> word, std::size_t lane) -> int
+{
+  constexpr auto mask = (std::uint64_t {1} << BitWidth) - 1;
+  constexpr auto sign = std::int64_t {1} << (BitWidth - 1);
+
+  const auto bits = static_cast<std::uint64_t>(_multiple_int_access::value(word));
+  const auto field = (bits >> (lane * (BitWidth + 1))) & mask;
+
+  return static_cast<int>((static_cast<std::int64_t>(field) ^ sign) - sign);
+}
+
+// Replaces the integer in lane of word with the lowest BitWidth bits of value, the carry bit is left untouched
+template<std::size_t BitWidth, typename BackingStorage>
+constexpr auto _set_lane(multiple_int<BitWidth, BackingStorage>& word, std::size_t lane, int value) -> void
+{
+  constexpr auto mask = (std::uint64_t {1} << BitWidth) - 1;
+
+  const auto shift = lane * (BitWidth + 1);
+  const auto bits = static_cast<std::uint64_t>(_multiple_int_access::value(word));
+  const auto field = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(value)) & mask) << shift;
+
+  word = _multiple_int_access::make<multiple_int<BitWidth, BackingStorage>>(
+      static_cast<BackingStorage>((bits & ~(mask << shift)) | field));
+}
+}  // namespace detail
+
+// A sequence of ints stored packed in multiple_int<BitWidth, BackingStorage> words, with the interface of
+// std::vector: the integer with index i is stored at index i % IntCount of word i / IntCount. Like the
+// elements of a std::vector<std::int8_t>, stored values are truncated to their lowest BitWidth bits. The
+// elements are accessed through proxy references, words() gives the words for the array algorithms.
+// Unused lanes of the last word are always zero.
+template<std::size_t BitWidth, std::unsigned_integral BackingStorage>
+class packed_vector
+{
+public:
+  using word_type = multiple_int<BitWidth, BackingStorage>;
+  using value_type = int;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using const_reference = int;
+
+  // Refers to the integer in a lane of a word, assigning to a const reference writes the integer like the
+  // proxies of std::vector<bool> (so the iterators are indirectly_writable)
+  class reference
+  {
+  public:
+    constexpr reference(word_type* word, std::size_t lane)
+        : word_ {word}
+        , lane_ {lane}
+    {
+    }
+
+    constexpr reference(const reference&) = default;
+
+    constexpr operator int() const { return detail::_get_lane(*word_, lane_); }
+
+    constexpr auto operator=(int value) const -> const reference&
+    {
+      detail::_set_lane(*word_, lane_, value);
+
+      return *this;
+    }
+
+    constexpr auto operator=(const reference& other) const -> const reference&
+    {
+      return *this = static_cast<int>(other);
+    }
+
+    constexpr auto operator+=(int value) const -> const reference& { return *this = static_cast<int>(*this) + value; }
+
+    constexpr auto operator-=(int value) const -> const reference& { return *this = static_cast<int>(*this) - value; }
+
+    friend constexpr void swap(reference lhs, reference rhs)
+    {
+      const int value = lhs;
+      lhs = static_cast<int>(rhs);
+      rhs = value;
+    }
+
+  private:
+    word_type* word_;
+    std::size_t lane_;
+  };
+
+private:
+  static constexpr auto int_count = static_cast<std::size_t>(word_type::IntCount);
+
+  // Random access over the integers, Const iterators read them as int
+  template<bool Const>
+  class basic_iterator
+  {
+    using word_pointer = std::conditional_t<Const, const word_type*, word_type*>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using iterator_concept = std::random_access_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using reference = std::conditional_t<Const, int, typename packed_vector::reference>;
+    using pointer = void;
+
+    constexpr basic_iterator() = default;
+
+    constexpr basic_iterator(word_pointer words, std::size_t index)
+        : words_ {words}
+        , index_ {index}
+    {
+    }
+
+    // iterator -> const_iterator
+    template<bool OtherConst>
+    requires(Const && !OtherConst)
+    constexpr basic_iterator(basic_iterator<OtherConst> other)
+        : words_ {other.words_}
+        , index_ {other.index_}
+    {
+    }
+
+    constexpr auto operator*() const -> reference
+    {
+      if constexpr (Const)
+        return detail::_get_lane(words_[index_ / int_count], index_ % int_count);
+      else
+        return reference {words_ + index_ / int_count, index_ % int_count};
+    }
+
+    constexpr auto operator[](difference_type n) const -> reference { return *(*this + n); }
+
+    constexpr auto operator++() -> basic_iterator&
+    {
+      ++index_;
+      return *this;
+    }
+
+    constexpr auto operator++(int) -> basic_iterator
+    {
+      auto copy = *this;
+      ++index_;
+      return copy;
+    }
+
+    constexpr auto operator--() -> basic_iterator&
+    {
+      --index_;
+      return *this;
+    }
+
+    constexpr auto operator--(int) -> basic_iterator
+    {
+      auto copy = *this;
+      --index_;
+      return copy;
+    }
+
+    constexpr auto operator+=(difference_type n) -> basic_iterator&
+    {
+      index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + n);
+      return *this;
+    }
+
+    constexpr auto operator-=(difference_type n) -> basic_iterator& { return *this += -n; }
+
+    friend constexpr auto operator+(basic_iterator it, difference_type n) -> basic_iterator { return it += n; }
+
+    friend constexpr auto operator+(difference_type n, basic_iterator it) -> basic_iterator { return it += n; }
+
+    friend constexpr auto operator-(basic_iterator it, difference_type n) -> basic_iterator { return it -= n; }
+
+    friend constexpr auto operator-(basic_iterator lhs, basic_iterator rhs) -> difference_type
+    {
+      return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+    }
+
+    friend constexpr auto operator==(basic_iterator lhs, basic_iterator rhs) -> bool
+    {
+      return lhs.index_ == rhs.index_;
+    }
+
+    friend constexpr auto operator<=>(basic_iterator lhs, basic_iterator rhs) -> std::strong_ordering
+    {
+      return lhs.index_ <=> rhs.index_;
+    }
+
+  private:
+    friend basic_iterator<!Const>;
+
+    word_pointer words_ = nullptr;
+    std::size_t index_ = 0;
+  };
+
+public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+private:
+  std::vector<word_type> words_;
+  std::size_t size_ = 0;
+
+public:
+  // Default ctor = empty vector
+  constexpr packed_vector() = default;
+
+  constexpr explicit packed_vector(size_type count, int value = 0) { resize(count, value); }
+
+  constexpr packed_vector(std::initializer_list<int> values)
+  {
+    reserve(values.size());
+
+    for (auto value : values)
+      push_back(value);
+  }
+
+  template<std::input_iterator InputIterator>
+  constexpr packed_vector(InputIterator first, InputIterator last)
+  {
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+
+  constexpr auto size() const -> size_type { return size_; }
+
+  constexpr auto empty() const -> bool { return size_ == 0; }
+
+  // Number of integers that fit into the allocated words
+  constexpr auto capacity() const -> size_type { return words_.capacity() * int_count; }
+
+  constexpr auto reserve(size_type count) -> void { words_.reserve((count + int_count - 1) / int_count); }
+
+  constexpr auto clear() -> void
+  {
+    words_.clear();
+    size_ = 0;
+  }
+
+  constexpr auto resize(size_type count, int value = 0) -> void
+  {
+    if (count <= size_) {
+      words_.resize((count + int_count - 1) / int_count);
+      size_ = count;
+
+      // Clear the lanes that became unused
+      for (auto i = count; i % int_count != 0; ++i)
+        detail::_set_lane(words_.back(), i % int_count, 0);
+
+      return;
+    }
+
+    // Fill up the last word, then whole words at once
+    while (size_ < count && size_ % int_count != 0)
+      push_back(value);
+
+    const auto full_words = (count - size_) / int_count;
+
+    words_.resize(words_.size() + full_words, word_type::broadcast(value));
+    size_ += full_words * int_count;
+
+    while (size_ < count)
+      push_back(value);
+  }
+
+  // Appends value, a new word is added every IntCount integers (amortized constant like std::vector)
+  constexpr auto push_back(int value) -> void
+  {
+    if (size_ % int_count == 0)
+      words_.emplace_back();
+
+    detail::_set_lane(words_.back(), size_ % int_count, value);
+    ++size_;
+  }
+
+  constexpr auto pop_back() -> void { resize(size_ - 1); }
+
+  constexpr auto operator[](size_type index) -> reference
+  {
+    return reference {words_.data() + index / int_count, index % int_count};
+  }
+
+  constexpr auto operator[](size_type index) const -> const_reference
+  {
+    return detail::_get_lane(words_[index / int_count], index % int_count);
+  }
+
+  constexpr auto front() -> reference { return (*this)[0]; }
+  constexpr auto front() const -> const_reference { return (*this)[0]; }
+
+  constexpr auto back() -> reference { return (*this)[size_ - 1]; }
+  constexpr auto back() const -> const_reference { return (*this)[size_ - 1]; }
+
+  constexpr auto begin() -> iterator { return iterator {words_.data(), 0}; }
+  constexpr auto end() -> iterator { return iterator {words_.data(), size_}; }
+
+  constexpr auto begin() const -> const_iterator { return const_iterator {words_.data(), 0}; }
+  constexpr auto end() const -> const_iterator { return const_iterator {words_.data(), size_}; }
+
+  constexpr auto cbegin() const -> const_iterator { return begin(); }
+  constexpr auto cend() const -> const_iterator { return end(); }
+
+  // The ceil(size() / IntCount) words holding the integers
+  constexpr auto words() -> std::span<word_type> { return words_; }
+  constexpr auto words() const -> std::span<const word_type> { return words_; }
+
+  friend constexpr auto operator==(const packed_vector& lhs, const packed_vector& rhs) -> bool
+  {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+};
+}  // namespace multipleint
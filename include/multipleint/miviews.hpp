@@ -0,0 +1,299 @@
+#pragma once
+
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#include "mi.hpp"
+
+namespace multipleint
+{
+
+namespace detail
+{
+template<class T>
+struct _is_multiple_int : std::false_type
+{
+};
+
+template<std::size_t BitWidth, typename BackingStorage>
+struct _is_multiple_int<multiple_int<BitWidth, BackingStorage>> : std::true_type
+{
+  static constexpr std::size_t bit_width = BitWidth;
+};
+
+template<class R>
+concept _range_of_multiple_ints =
+    std::ranges::input_range<R> && _is_multiple_int<std::ranges::range_value_t<R>>::value;
+
+template<class R>
+concept _range_of_ints = std::ranges::input_range<R> && std::convertible_to<std::ranges::range_reference_t<R>, int>;
+}  // namespace detail
+
+// The integers of a range of multiple_ints, index i % IntCount of word i / IntCount is element i (including the
+// unused lanes of a partially filled last word). Every word is read once when the iteration reaches it, its
+// integers are then shifted out of the copy in a register.
+/* clang-format off */
+template<std::ranges::view V>
+requires detail::_range_of_multiple_ints<V>
+class unpacked_view : public std::ranges::view_interface<unpacked_view<V>>
+/* clang-format on */
+{
+  using word_type = std::ranges::range_value_t<V>;
+
+  static constexpr auto int_count = static_cast<std::size_t>(word_type::IntCount);
+  static constexpr auto bit_width = detail::_is_multiple_int<word_type>::bit_width;
+
+  V base_ = V();
+
+  class iterator
+  {
+  public:
+    using iterator_concept =
+        std::conditional_t<std::ranges::forward_range<V>, std::forward_iterator_tag, std::input_iterator_tag>;
+    using value_type = int;
+    using difference_type = std::ranges::range_difference_t<V>;
+
+    iterator() = default;
+
+    constexpr iterator(std::ranges::iterator_t<V> current, std::ranges::sentinel_t<V> end)
+        : current_ {std::move(current)}
+        , end_ {std::move(end)}
+    {
+      load();
+    }
+
+    constexpr auto operator*() const -> int
+    {
+      constexpr auto mask = (std::uint64_t {1} << bit_width) - 1;
+      constexpr auto sign = std::int64_t {1} << (bit_width - 1);
+
+      return static_cast<int>((static_cast<std::int64_t>(lanes_ & mask) ^ sign) - sign);
+    }
+
+    constexpr auto operator++() -> iterator&
+    {
+      if (++lane_ == int_count) {
+        lane_ = 0;
+        ++current_;
+        load();
+      } else {
+        lanes_ >>= bit_width + 1;
+      }
+
+      return *this;
+    }
+
+    constexpr auto operator++(int)
+    {
+      if constexpr (std::ranges::forward_range<V>) {
+        auto copy = *this;
+        ++*this;
+        return copy;
+      } else {
+        ++*this;
+      }
+    }
+
+    friend constexpr auto operator==(const iterator& lhs, const iterator& rhs) -> bool
+    requires std::equality_comparable<std::ranges::iterator_t<V>>
+    {
+      return lhs.current_ == rhs.current_ && lhs.lane_ == rhs.lane_;
+    }
+
+    friend constexpr auto operator==(const iterator& it, std::default_sentinel_t) -> bool { return it.at_end(); }
+
+  private:
+    std::ranges::iterator_t<V> current_ = std::ranges::iterator_t<V>();
+    std::ranges::sentinel_t<V> end_ = std::ranges::sentinel_t<V>();
+    std::size_t lane_ = 0;
+    std::uint64_t lanes_ = 0;  // the word shifted such that the current lane is the lowest
+
+    constexpr auto at_end() const -> bool { return current_ == end_; }
+
+    constexpr auto load() -> void
+    {
+      if (!at_end())
+        lanes_ = static_cast<std::uint64_t>(detail::_multiple_int_access::value(*current_));
+    }
+  };
+
+public:
+  unpacked_view() = default;
+
+  constexpr explicit unpacked_view(V base)
+      : base_ {std::move(base)}
+  {
+  }
+
+  constexpr auto base() const& -> V requires std::copy_constructible<V> { return base_; }
+  constexpr auto base() && -> V { return std::move(base_); }
+
+  constexpr auto begin() { return iterator {std::ranges::begin(base_), std::ranges::end(base_)}; }
+
+  constexpr auto end() const { return std::default_sentinel; }
+
+  constexpr auto size() requires std::ranges::sized_range<V>
+  {
+    return std::ranges::size(base_) * int_count;
+  }
+};
+
+// A range of ints packed into multiple_int<BitWidth, BackingStorage> words, IntCount integers are read and
+// encoded at once. The unused lanes of the last word are zero.
+/* clang-format off */
+template<std::ranges::view V, std::size_t BitWidth, std::unsigned_integral BackingStorage>
+requires detail::_range_of_ints<V>
+class packed_view : public std::ranges::view_interface<packed_view<V, BitWidth, BackingStorage>>
+/* clang-format on */
+{
+  using word_type = multiple_int<BitWidth, BackingStorage>;
+
+  static constexpr auto int_count = static_cast<std::size_t>(word_type::IntCount);
+
+  V base_ = V();
+
+  class iterator
+  {
+  public:
+    using iterator_concept =
+        std::conditional_t<std::ranges::forward_range<V>, std::forward_iterator_tag, std::input_iterator_tag>;
+    using value_type = word_type;
+    using difference_type = std::ranges::range_difference_t<V>;
+
+    iterator() = default;
+
+    constexpr iterator(packed_view& parent, std::ranges::iterator_t<V> current)
+        : parent_ {&parent}
+        , next_ {std::move(current)}
+    {
+      encode();
+    }
+
+    constexpr auto operator*() const -> word_type { return word_; }
+
+    constexpr auto operator++() -> iterator&
+    {
+      encode();
+      return *this;
+    }
+
+    constexpr auto operator++(int)
+    {
+      if constexpr (std::ranges::forward_range<V>) {
+        auto copy = *this;
+        ++*this;
+        return copy;
+      } else {
+        ++*this;
+      }
+    }
+
+    friend constexpr auto operator==(const iterator& lhs, const iterator& rhs) -> bool
+    requires std::equality_comparable<std::ranges::iterator_t<V>>
+    {
+      return lhs.next_ == rhs.next_ && lhs.at_end_ == rhs.at_end_;
+    }
+
+    friend constexpr auto operator==(const iterator& it, std::default_sentinel_t) -> bool { return it.at_end_; }
+
+  private:
+    packed_view* parent_ = nullptr;
+    std::ranges::iterator_t<V> next_ = std::ranges::iterator_t<V>();  // the integer after the current word
+    word_type word_ {};
+    bool at_end_ = false;
+
+    // Reads the next IntCount integers into word_
+    constexpr auto encode() -> void
+    {
+      const auto end = std::ranges::end(parent_->base_);
+
+      if (next_ == end) {
+        at_end_ = true;
+        return;
+      }
+
+      std::array<int, int_count> values {};
+
+      for (std::size_t i = 0; i < int_count && next_ != end; ++i, ++next_)
+        values[i] = static_cast<int>(*next_);
+
+      word_ = word_type::encode(values);
+    }
+  };
+
+public:
+  packed_view() = default;
+
+  constexpr explicit packed_view(V base)
+      : base_ {std::move(base)}
+  {
+  }
+
+  constexpr auto base() const& -> V requires std::copy_constructible<V> { return base_; }
+  constexpr auto base() && -> V { return std::move(base_); }
+
+  constexpr auto begin() { return iterator {*this, std::ranges::begin(base_)}; }
+
+  constexpr auto end() const { return std::default_sentinel; }
+
+  constexpr auto size() requires std::ranges::sized_range<V>
+  {
+    return (std::ranges::size(base_) + int_count - 1) / int_count;
+  }
+};
+
+namespace views
+{
+
+namespace detail
+{
+struct _unpacked_fn
+{
+  template<std::ranges::viewable_range R>
+  requires multipleint::detail::_range_of_multiple_ints<R>
+  constexpr auto operator()(R&& r) const
+  {
+    return unpacked_view<std::views::all_t<R>> {std::views::all(std::forward<R>(r))};
+  }
+
+  template<std::ranges::viewable_range R>
+  requires multipleint::detail::_range_of_multiple_ints<R>
+  friend constexpr auto operator|(R&& r, const _unpacked_fn& fn)
+  {
+    return fn(std::forward<R>(r));
+  }
+};
+
+template<std::size_t BitWidth, std::unsigned_integral BackingStorage>
+struct _packed_fn
+{
+  template<std::ranges::viewable_range R>
+  requires multipleint::detail::_range_of_ints<R>
+  constexpr auto operator()(R&& r) const
+  {
+    return packed_view<std::views::all_t<R>, BitWidth, BackingStorage> {std::views::all(std::forward<R>(r))};
+  }
+
+  template<std::ranges::viewable_range R>
+  requires multipleint::detail::_range_of_ints<R>
+  friend constexpr auto operator|(R&& r, const _packed_fn& fn)
+  {
+    return fn(std::forward<R>(r));
+  }
+};
+}  // namespace detail
+
+// data | views::unpacked is the range of the integers of the multiple_ints in data
+inline constexpr detail::_unpacked_fn unpacked {};
+
+// ints | views::packed<BitWidth, BackingStorage> is the range of multiple_int words holding ints
+template<std::size_t BitWidth, std::unsigned_integral BackingStorage>
+inline constexpr detail::_packed_fn<BitWidth, BackingStorage> packed {};
+}  // namespace views
+}  // namespace multipleint
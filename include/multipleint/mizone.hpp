@@ -0,0 +1,263 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include "mi.hpp"
+#include "mibatch.hpp"
+#include "micpu.hpp"
+#include "milimits.hpp"
+
+namespace multipleint
+{
+
+// Smallest and largest integer of a block of words
+struct zone
+{
+  int min;
+  int max;
+};
+
+// Words of multiple_ints with a zone map: the smallest and the largest integer of every block of BlockWords
+// words, which is kept up to date on every write. max_red, find_first and range_scan skip the blocks whose
+// zone shows that they cannot contribute, so on clustered data (e.g. mostly sorted) only a few blocks are read.
+// The zones cover all lanes, the carry bits are ignored.
+/* clang-format off */
+template<std::size_t BitWidth, std::unsigned_integral BackingStorage, std::size_t BlockWords = 64>
+requires(BlockWords > 0)
+class zoned_array
+/* clang-format on */
+{
+public:
+  using value_type = multiple_int<BitWidth, BackingStorage>;
+
+  static constexpr std::size_t block_words = BlockWords;
+
+private:
+  static constexpr auto int_count = static_cast<std::size_t>(value_type::IntCount);
+
+  std::vector<value_type> words_;
+  std::vector<zone> zones_;
+
+public:
+  // Default ctor = no words
+  zoned_array() = default;
+
+  // words zero words
+  explicit zoned_array(std::size_t words)
+      : words_(words)
+      , zones_((words + BlockWords - 1) / BlockWords, zone {0, 0})
+  {
+  }
+
+  explicit zoned_array(std::span<const value_type> words)
+      : words_(words.begin(), words.end())
+      , zones_((words.size() + BlockWords - 1) / BlockWords)
+  {
+    for (std::size_t block = 0; block < zones_.size(); ++block)
+      update_zone(block);
+  }
+
+  auto size() const -> std::size_t { return words_.size(); }
+
+  auto words() const -> std::span<const value_type> { return words_; }
+
+  auto operator[](std::size_t index) const -> value_type { return words_[index]; }
+
+  auto block_count() const -> std::size_t { return zones_.size(); }
+
+  auto zones() const -> std::span<const zone> { return zones_; }
+
+  // The words of block, only the last one may hold less than BlockWords
+  auto block(std::size_t block) const -> std::span<const value_type>
+  {
+    const auto first = block * BlockWords;
+
+    return std::span {words_}.subspan(first, std::min(BlockWords, words_.size() - first));
+  }
+
+  auto set(std::size_t index, value_type word) -> void
+  {
+    words_[index] = word;
+    update_zone(index / BlockWords);
+  }
+
+  // Overwrites the words starting at first with words
+  auto assign(std::size_t first, std::span<const value_type> words) -> void
+  {
+    if (words.empty())
+      return;
+
+    std::copy(words.begin(), words.end(), words_.begin() + static_cast<std::ptrdiff_t>(first));
+
+    for (auto block = first / BlockWords; block * BlockWords < first + words.size(); ++block)
+      update_zone(block);
+  }
+
+  // The smallest integer in all lanes of word
+  static constexpr auto lane_min(value_type word) -> int
+  {
+    const auto values = word.template decode<int_count>();
+
+    return *std::min_element(values.begin(), values.end());
+  }
+
+private:
+  // The element-wise max and min of all words, the zone comes from their horizontal max and min
+  auto update_zone(std::size_t index) -> void
+  {
+    const auto words = block(index);
+
+    auto maximum = words[0];
+    auto minimum = words[0];
+
+    for (const auto& word : words.subspan(1)) {
+      maximum = max(maximum, word);
+      minimum = min(minimum, word);
+    }
+
+    zones_[index] = zone {lane_min(minimum), static_cast<int>(maximum.max())};
+  }
+};
+
+// The element-wise maximum of init and all words. The block with the largest zone max is reduced first, all
+// blocks whose zone max does not exceed the smallest lane of that result are skipped. Unlike max_red on a
+// span, the carry bits of the skipped words are never merged into the result.
+template<class Exec, std::size_t BitWidth, typename BackingStorage, std::size_t BlockWords>
+auto max_red(Exec&& exec,
+             const zoned_array<BitWidth, BackingStorage, BlockWords>& x,
+             multiple_int<BitWidth, BackingStorage> init) -> multiple_int<BitWidth, BackingStorage>
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+  using array_type = zoned_array<BitWidth, BackingStorage, BlockWords>;
+
+  static const auto kernel =
+      detail::_dispatched_kernel<detail::_batch_reduce_kernel<detail::_maximum>, const T*, std::size_t, T*>();
+
+  if (x.block_count() == 0)
+    return init;
+
+  const auto zones = x.zones();
+  const auto top = static_cast<std::size_t>(
+      std::max_element(zones.begin(), zones.end(), [](zone lhs, zone rhs) { return lhs.max < rhs.max; })
+      - zones.begin());
+
+  auto seed = init;
+  kernel(x.block(top).data(), x.block(top).size(), &seed);
+
+  const auto bound = array_type::lane_min(seed);
+
+  std::vector<std::size_t> blocks(x.block_count());
+  std::iota(blocks.begin(), blocks.end(), std::size_t {0});
+
+  return std::transform_reduce(std::forward<Exec>(exec),
+                               blocks.begin(),
+                               blocks.end(),
+                               seed,
+                               detail::_maximum {},
+                               [&](std::size_t block) -> T
+                               {
+                                 auto partial = std::numeric_limits<T>::lowest();
+
+                                 if (block != top && zones[block].max > bound)
+                                   kernel(x.block(block).data(), x.block(block).size(), &partial);
+
+                                 return partial;
+                               });
+}
+
+// Returns the logical index (word index * IntCount + lane index) of the first integer equal to value,
+// x.size() * IntCount if there is none. Only the blocks whose zone contains value are searched.
+template<class Exec, std::size_t BitWidth, typename BackingStorage, std::size_t BlockWords>
+auto find_first(Exec&& exec, const zoned_array<BitWidth, BackingStorage, BlockWords>& x, int value) -> std::size_t
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+  const auto zones = x.zones();
+
+  std::vector<std::size_t> blocks(zones.size());
+  std::iota(blocks.begin(), blocks.end(), std::size_t {0});
+
+  const auto found = std::find_if(std::forward<Exec>(exec),
+                                  blocks.begin(),
+                                  blocks.end(),
+                                  [&](std::size_t block)
+                                  {
+                                    const auto words = x.block(block);
+
+                                    return zones[block].min <= value && value <= zones[block].max
+                                        && std::any_of(words.begin(),
+                                                       words.end(),
+                                                       [value](const T& word) { return word.contains(value); });
+                                  });
+
+  if (found == blocks.end())
+    return x.size() * int_count;
+
+  const auto first = *found * BlockWords;
+  const auto words = x.block(first / BlockWords);
+  const auto word = std::find_if(words.begin(), words.end(), [value](const T& w) { return w.contains(value); });
+
+  return (first + static_cast<std::size_t>(word - words.begin())) * int_count
+      + static_cast<std::size_t>(word->find_lane(value));
+}
+
+// Evaluates lo <= x <= hi for every integer and writes the results as a bitmap like range_scan on a range of
+// words. The words of blocks whose zone lies outside of [lo, hi] are never read, the ones of blocks whose zone
+// lies within it neither.
+template<class Exec, std::size_t BitWidth, typename BackingStorage, std::size_t BlockWords>
+void range_scan(Exec&& exec,
+                const zoned_array<BitWidth, BackingStorage, BlockWords>& x,
+                int lo,
+                int hi,
+                std::span<std::uint64_t> out_bitmap)
+{
+  using T = multiple_int<BitWidth, BackingStorage>;
+
+  constexpr std::size_t bitmap_bits = 64;
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+  constexpr auto all_lanes = (std::uint64_t {1} << int_count) - 1;
+
+  const auto n = x.size();
+  const auto bitmap_words = (n * int_count + bitmap_bits - 1) / bitmap_bits;
+  const auto zones = x.zones();
+
+  std::vector<std::size_t> indices(bitmap_words);
+  std::iota(indices.begin(), indices.end(), std::size_t {0});
+
+  // Every bitmap word is assembled from all multiple_ints overlapping it, see range_scan on a range of words
+  std::for_each(std::forward<Exec>(exec),
+                indices.begin(),
+                indices.end(),
+                [&](std::size_t index)
+                {
+                  const auto first = index * bitmap_bits;
+
+                  std::uint64_t bits = 0;
+
+                  for (auto word = first / int_count; word < n && word * int_count < first + bitmap_bits; ++word) {
+                    const auto& z = zones[word / BlockWords];
+
+                    if (z.max < lo || z.min > hi)
+                      continue;
+
+                    const auto mask = (lo <= z.min && z.max <= hi) ? all_lanes : x[word].in_range(lo, hi);
+                    const auto position = word * int_count;
+
+                    bits |= (position < first) ? (mask >> (first - position)) : (mask << (position - first));
+                  }
+
+                  out_bitmap[index] = bits;
+                });
+}
+}  // namespace multipleint
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/mibatch.hpp>
+
+TEST(Batch, LoadStore)
+{
+  using m_int = multipleint::multiple_int<7, std::uint64_t>;
+  using batch = multipleint::multiple_int_batch<7, std::uint64_t, 4>;
+
+  const std::array<m_int, 5> words {
+      m_int::broadcast(1), m_int::broadcast(-2), m_int::broadcast(3), m_int::broadcast(-4), m_int::broadcast(5)};
+
+  // Unaligned load
+  const auto b = batch::load(words.data() + 1);
+
+  EXPECT_EQ(m_int::broadcast(-2).decode<8>(), b[0].decode<8>());
+  EXPECT_EQ(m_int::broadcast(5).decode<8>(), b[3].decode<8>());
+
+  std::array<m_int, 4> out {};
+  batch {m_int::broadcast(9)}.store(out.data());
+
+  for (const auto& word : out)
+    EXPECT_EQ(m_int::broadcast(9).decode<8>(), word.decode<8>());
+}
+
+TEST(Batch, MatchesScalar)
+{
+  using m_int = multipleint::multiple_int<3, std::uint16_t>;
+  using batch = multipleint::multiple_int_batch<3, std::uint16_t, 8>;
+
+  // Every pair of values for one lane, including overflows and the minimum
+  std::array<m_int, 8> lhs {};
+  std::array<m_int, 8> rhs {};
+
+  for (int i = 0; i < 8; ++i) {
+    lhs[static_cast<std::size_t>(i)] = m_int::encode<4>({i - 4, i - 4, i - 4, i - 4});
+    rhs[static_cast<std::size_t>(i)] = m_int::encode<4>({-4, -1, 2, 3 - i});
+  }
+
+  const auto l = batch::load(lhs.data());
+  const auto r = batch::load(rhs.data());
+
+  const auto sum = l + r;
+  const auto difference = l - r;
+  const auto negated = -r;
+  const auto maximum = max(l, r);
+
+  for (std::size_t i = 0; i < 8; ++i) {
+    EXPECT_EQ((lhs[i] + rhs[i]).intv(), sum[i].intv());
+    EXPECT_EQ((lhs[i] + rhs[i]).carry(), sum[i].carry());
+
+    EXPECT_EQ((lhs[i] - rhs[i]).intv(), difference[i].intv());
+    EXPECT_EQ((lhs[i] - rhs[i]).carry(), difference[i].carry());
+
+    EXPECT_EQ((-rhs[i]).intv(), negated[i].intv());
+    EXPECT_EQ((-rhs[i]).carry(), negated[i].carry());
+
+    EXPECT_EQ(max(lhs[i], rhs[i]).intv(), maximum[i].intv());
+    EXPECT_EQ(max(lhs[i], rhs[i]).carry(), maximum[i].carry());
+  }
+}
+
+TEST(Batch, CarryPropagation)
+{
+  using m_int = multipleint::multiple_int<7, std::uint64_t>;
+  using batch = multipleint::multiple_int_batch<7, std::uint64_t, 2>;
+
+  const batch l {m_int::broadcast(63)};
+  const batch r {m_int::broadcast(1)};
+
+  // 63 + 1 overflows in every lane, the carry bits survive the following subtraction
+  const auto result = (l + r) - r;
+
+  EXPECT_EQ(m_int::traits::carry_mask, result[0].carry());
+  EXPECT_EQ(m_int::traits::carry_mask, result[1].carry());
+}
+
+template<std::size_t BitWidth, typename BackingStorage>
+static void expect_native_lanes_match_scalar(long long step)
+{
+  using m_int = multipleint::multiple_int<BitWidth, BackingStorage>;
+  using batch = multipleint::multiple_int_batch<BitWidth, BackingStorage, 2>;
+
+  constexpr long long lowest = -(1LL << (BitWidth - 1));
+  constexpr long long highest = (1LL << (BitWidth - 1)) - 1;
+
+  // The minimum and maximum as well as every step'th value in between, with and without carry bits
+  for (long long a = lowest; a <= highest; a = (a == highest) ? a + 1 : std::min(a + step, highest)) {
+    for (long long b = lowest; b <= highest; b = (b == highest) ? b + 1 : std::min(b + step, highest)) {
+      std::array<m_int, 2> lhs {m_int::broadcast(static_cast<int>(a)), m_int::broadcast(static_cast<int>(a))};
+      std::array<m_int, 2> rhs {m_int::broadcast(static_cast<int>(b)), m_int::broadcast(static_cast<int>(b))};
+
+      // Set the carry bits of the second word by overflowing it
+      lhs[1] = lhs[1] + m_int::broadcast(static_cast<int>(highest)) + m_int::broadcast(static_cast<int>(highest));
+      lhs[1] = lhs[1] - m_int::broadcast(static_cast<int>(highest)) - m_int::broadcast(static_cast<int>(highest));
+
+      const auto l = batch::load(lhs.data());
+      const auto r = batch::load(rhs.data());
+
+      for (std::size_t i = 0; i < 2; ++i) {
+        ASSERT_EQ((lhs[i] + rhs[i]).intv() | (lhs[i] + rhs[i]).carry(), (l + r)[i].intv() | (l + r)[i].carry());
+        ASSERT_EQ((lhs[i] - rhs[i]).intv() | (lhs[i] - rhs[i]).carry(), (l - r)[i].intv() | (l - r)[i].carry());
+        ASSERT_EQ((-lhs[i]).intv() | (-lhs[i]).carry(), (-l)[i].intv() | (-l)[i].carry());
+        ASSERT_EQ(max(lhs[i], rhs[i]).intv() | max(lhs[i], rhs[i]).carry(),
+                  max(l, r)[i].intv() | max(l, r)[i].carry());
+      }
+    }
+  }
+}
+
+TEST(Batch, NativeLanes)
+{
+  expect_native_lanes_match_scalar<7, std::uint64_t>(1);
+  expect_native_lanes_match_scalar<15, std::uint32_t>(97);
+  expect_native_lanes_match_scalar<31, std::uint64_t>(12'345'677);
+}
+
+TEST(Batch, UnpackPack)
+{
+  using m_int = multipleint::multiple_int<15, std::uint64_t>;
+  using batch = multipleint::multiple_int_batch<15, std::uint64_t, 4>;
+
+  const std::array<m_int, 4> words {m_int::encode<4>({-16384, 16383, 0, -1}),
+                                    m_int::encode<4>({1, 2, 3, 4}),
+                                    m_int::broadcast(-7) + m_int::broadcast(-16384),
+                                    m_int::encode<4>({-5, 6, -7, 8})};
+
+  const auto b = batch::load(words.data());
+  const auto lo = unpack_lo(b);
+  const auto hi = unpack_hi(b);
+  const auto packed = pack(lo, hi);
+
+  for (std::size_t i = 0; i < 4; ++i) {
+    EXPECT_EQ(multipleint::unpack_lo(words[i]).intv(), lo[i].intv());
+    EXPECT_EQ(multipleint::unpack_hi(words[i]).intv(), hi[i].intv());
+    EXPECT_EQ(0, lo[i].carry() | hi[i].carry());
+    EXPECT_EQ(words[i].intv(), packed[i].intv());
+    EXPECT_EQ(0, packed[i].carry());
+  }
+}
@@ -0,0 +1,140 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mialgorithm.hpp>
+#include <multipleint/mibitsliced.hpp>
+
+// Every pair of values appears at some index of lhs and rhs
+template<std::size_t BitWidth>
+static auto all_pairs() -> std::array<std::array<int, 64>, 2>
+{
+  using sliced = multipleint::bit_sliced<BitWidth>;
+
+  constexpr int range = 1 << BitWidth;
+
+  std::array<std::array<int, 64>, 2> values {};
+
+  for (int i = 0; i < 64; ++i) {
+    values[0][static_cast<std::size_t>(i)] = sliced::min_value + (i % range);
+    values[1][static_cast<std::size_t>(i)] = sliced::min_value + ((i / range) % range);
+  }
+
+  return values;
+}
+
+// value wrapped around into BitWidth bits
+template<std::size_t BitWidth>
+static auto wrap(int value) -> int
+{
+  constexpr int range = 1 << BitWidth;
+
+  return ((value - multipleint::bit_sliced<BitWidth>::min_value) % range + range) % range
+      + multipleint::bit_sliced<BitWidth>::min_value;
+}
+
+template<std::size_t BitWidth>
+static void expect_matches_scalar()
+{
+  using sliced = multipleint::bit_sliced<BitWidth>;
+
+  const auto [a, b] = all_pairs<BitWidth>();
+
+  const auto lhs = sliced::encode(a);
+  const auto rhs = sliced::encode(b);
+
+  EXPECT_EQ(a, lhs.template decode<64>());
+
+  const auto sum = (lhs + rhs).template decode<64>();
+  const auto difference = (lhs - rhs).template decode<64>();
+  const auto negated = (-lhs).template decode<64>();
+  const auto maximum = max(lhs, rhs).template decode<64>();
+  const auto minimum = min(lhs, rhs).template decode<64>();
+
+  for (std::size_t i = 0; i < 64; ++i) {
+    EXPECT_EQ(wrap<BitWidth>(a[i] + b[i]), sum[i]);
+    EXPECT_EQ(wrap<BitWidth>(a[i] - b[i]), difference[i]);
+    EXPECT_EQ(wrap<BitWidth>(-a[i]), negated[i]);
+    EXPECT_EQ(std::max(a[i], b[i]), maximum[i]);
+    EXPECT_EQ(std::min(a[i], b[i]), minimum[i]);
+
+    EXPECT_EQ(wrap<BitWidth>(a[i] + b[i]) != a[i] + b[i], (add_overflow(lhs, rhs) >> i) & 1);
+    EXPECT_EQ(wrap<BitWidth>(a[i] - b[i]) != a[i] - b[i], (subtract_overflow(lhs, rhs) >> i) & 1);
+    EXPECT_EQ(a[i] < b[i], (less(lhs, rhs) >> i) & 1);
+  }
+
+  int total = 0;
+
+  for (auto x : a)
+    total += x;
+
+  EXPECT_EQ(total, lhs.sum());
+  EXPECT_EQ(*std::max_element(a.begin(), a.end()), lhs.max());
+  EXPECT_EQ(sliced::min_value, sliced::broadcast(sliced::min_value).max());
+}
+
+TEST(BitSliced, MatchesScalar)
+{
+  expect_matches_scalar<1>();
+  expect_matches_scalar<2>();
+  expect_matches_scalar<3>();
+  expect_matches_scalar<4>();
+}
+
+template<std::size_t BitWidth>
+static void expect_predicates_match_scalar()
+{
+  using sliced = multipleint::bit_sliced<BitWidth>;
+
+  const auto a = all_pairs<BitWidth>()[0];
+  const auto block = sliced::encode(a);
+
+  for (int value = sliced::min_value - 1; value <= sliced::max_value + 1; ++value) {
+    const auto expected_count = std::count(a.begin(), a.end(), value);
+    const auto expected_lane = std::find(a.begin(), a.end(), value) - a.begin();
+
+    EXPECT_EQ(expected_count, block.count(value));
+    EXPECT_EQ(expected_count != 0, block.contains(value));
+    EXPECT_EQ(expected_lane, block.find_lane(value));
+
+    for (int hi = sliced::min_value - 1; hi <= sliced::max_value + 1; ++hi) {
+      std::uint64_t expected = 0;
+
+      for (std::size_t i = 0; i < 64; ++i)
+        expected |= static_cast<std::uint64_t>(value <= a[i] && a[i] <= hi) << i;
+
+      EXPECT_EQ(expected, block.in_range(value, hi));
+    }
+  }
+}
+
+TEST(BitSliced, Predicates)
+{
+  expect_predicates_match_scalar<1>();
+  expect_predicates_match_scalar<2>();
+  expect_predicates_match_scalar<3>();
+  expect_predicates_match_scalar<4>();
+}
+
+TEST(BitSliced, ArrayAlgorithms)
+{
+  using sliced = multipleint::bit_sliced<2>;
+
+  std::vector<sliced> blocks(100, sliced::broadcast(-1));
+  blocks[42].encode(17, 1);
+
+  EXPECT_EQ(42 * 64 + 17, multipleint::find_first(std::execution::par_unseq, blocks.begin(), blocks.end(), 1));
+  EXPECT_EQ(1, multipleint::count_equal(std::execution::par_unseq, blocks.begin(), blocks.end(), 1));
+
+  // Every bitmap word is the mask of one block
+  std::vector<std::uint64_t> bitmap(blocks.size());
+  multipleint::range_scan(std::execution::par_unseq, blocks.begin(), blocks.end(), 0, 1, std::span {bitmap});
+
+  EXPECT_EQ(std::uint64_t {1} << 17, bitmap[42]);
+  EXPECT_EQ(0, std::count_if(bitmap.begin(), bitmap.end(), [](std::uint64_t bits) { return bits != 0; }) - 1);
+}
@@ -0,0 +1,103 @@
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/mialgorithm.hpp>
+
+TEST(BulkConversion, EncodeTail)
+{
+  using m_int = multipleint::multiple_int<7, std::uint64_t>;
+
+  // 8 integers per word -> 2 full words and 3 integers in the last one
+  const std::vector<std::int32_t> in {0, 1, -1, 63, -64, 5, -5, 17, 2, 3, 4, 5, 6, 7, 8, 9, -10, 11, -12};
+
+  std::vector<m_int> out(4, m_int::broadcast(1));
+  multipleint::encode_bulk(std::execution::par_unseq, in, std::span {out});
+
+  EXPECT_EQ((std::array {0, 1, -1, 63, -64, 5, -5, 17}), out[0].decode<8>());
+  EXPECT_EQ((std::array {2, 3, 4, 5, 6, 7, 8, 9}), out[1].decode<8>());
+  EXPECT_EQ((std::array {-10, 11, -12, 0, 0, 0, 0, 0}), out[2].decode<8>());
+
+  // Words past the encoded integers are untouched
+  EXPECT_EQ(m_int::broadcast(1).decode<8>(), out[3].decode<8>());
+}
+
+TEST(BulkConversion, RoundTrip)
+{
+  using m_int = multipleint::multiple_int<9, std::uint32_t>;
+
+  std::vector<std::int32_t> in(10001);
+  std::iota(in.begin(), in.end(), -5000);
+
+  for (auto& x : in)
+    x %= 256;
+
+  std::vector<m_int> packed((in.size() + m_int::IntCount - 1) / m_int::IntCount);
+  multipleint::encode_bulk(std::execution::par_unseq, in, std::span {packed});
+
+  std::vector<std::int32_t> out(in.size() + 1, 42);
+  multipleint::decode_bulk(
+      std::execution::par_unseq, std::span<const m_int> {packed}, std::span {out}.first(in.size()));
+
+  EXPECT_TRUE(std::equal(in.begin(), in.end(), out.begin()));
+  EXPECT_EQ(42, out.back());
+}
+
+TEST(BulkConversion, Bmi2Kernels)
+{
+#if MULTIPLEINT_X86
+  if (!multipleint::detail::cpu_features().bmi2)
+    GTEST_SKIP() << "CPU without BMI2";
+
+  using m_int = multipleint::multiple_int<3, std::uint64_t>;
+
+  // 16 integers per word, every value of 3 bits twice
+  std::vector<std::int32_t> in(16 * 100);
+
+  for (std::size_t i = 0; i < in.size(); ++i)
+    in[i] = static_cast<std::int32_t>(i % 8) - 4;
+
+  std::vector<m_int> portable(100);
+  std::vector<m_int> bmi2(100);
+
+  multipleint::detail::_encode_words(in.data(), portable.data(), portable.size());
+  multipleint::detail::_encode_words_bmi2(in.data(), bmi2.data(), bmi2.size());
+
+  for (std::size_t i = 0; i < portable.size(); ++i)
+    ASSERT_EQ(portable[i].intv(), bmi2[i].intv());
+
+  std::vector<std::int32_t> out(in.size());
+  multipleint::detail::_decode_words_bmi2(bmi2.data(), out.data(), bmi2.size());
+
+  EXPECT_EQ(in, out);
+#else
+  GTEST_SKIP() << "Not an x86 build";
+#endif
+}
+
+TEST(BulkConversion, UpAndDowncast)
+{
+  using small_int = multipleint::multiple_int<5, std::uint16_t>;
+  using big_int = multipleint::multiple_int<11, std::uint32_t>;
+
+  std::vector<small_int> small(1000);
+
+  for (std::size_t i = 0; i < small.size(); ++i)
+    small[i] = small_int::encode<2>({static_cast<int>(i % 32) - 16, 15 - static_cast<int>(i % 32)});
+
+  std::vector<big_int> big(small.size());
+  multipleint::upcast(std::execution::par_unseq, std::span<const small_int> {small}, std::span {big});
+
+  std::vector<small_int> back(small.size());
+  multipleint::downcast(std::execution::par_unseq, std::span<const big_int> {big}, std::span {back});
+
+  for (std::size_t i = 0; i < small.size(); ++i) {
+    ASSERT_EQ(small[i].decode<2>(), big[i].decode<2>());
+    ASSERT_EQ(small[i].decode<2>(), back[i].decode<2>());
+  }
+}
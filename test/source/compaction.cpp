@@ -0,0 +1,74 @@
+#include <array>
+#include <cstdint>
+#include <execution>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/mialgorithm.hpp>
+
+TEST(Compaction, Word)
+{
+  using target_type = multipleint::multiple_int<7, std::uint64_t>;
+
+  constexpr auto num = target_type::encode<8>({5, -3, 63, 0, -64, -4, 17, -1});
+
+  constexpr auto compacted = num.compact(0b1010'0110);
+
+  EXPECT_EQ(-3, compacted.extract<0>());
+  EXPECT_EQ(63, compacted.extract<1>());
+  EXPECT_EQ(-4, compacted.extract<2>());
+  EXPECT_EQ(-1, compacted.extract<3>());
+  EXPECT_EQ(0, compacted.extract<4>());
+  EXPECT_EQ(0, compacted.extract<7>());
+
+  EXPECT_EQ(num.decode<8>(), num.compact(0b1111'1111).decode<8>());
+  EXPECT_EQ(target_type {}.decode<8>(), num.compact(0).decode<8>());
+}
+
+TEST(Compaction, Bitmap)
+{
+  // 3 integers per word -> words overlap the bitmap words and the compacted output words
+  using m_int = multipleint::multiple_int<16, std::uint64_t>;
+
+  std::vector<m_int> v(3000);
+
+  for (std::size_t i = 0; i < v.size(); ++i)
+    v[i] = m_int::encode<3>({static_cast<int>(3 * i % 1000), -1, static_cast<int>((3 * i + 2) % 1000)});
+
+  // Keep every integer whose logical index is divisible by 4
+  std::vector<std::uint64_t> bitmap((v.size() * 3 + 63) / 64, 0x1111'1111'1111'1111);
+
+  std::vector<m_int> out(v.size());
+  const auto count = multipleint::compact(std::execution::par_unseq, v.cbegin(), v.cend(), bitmap, out.begin());
+
+  ASSERT_EQ(2250, count);
+
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto index = 4 * i;
+    const auto expected = (index % 3 == 1) ? -1 : static_cast<int>(index % 3000 % 1000);
+
+    ASSERT_EQ(expected, out[i / 3].decode<3>()[i % 3]);
+  }
+}
+
+TEST(Compaction, Predicate)
+{
+  using m_int = multipleint::multiple_int<3, std::uint8_t>;
+
+  std::vector<m_int> v(5000, m_int::encode<2>({1, -4}));
+  v[4321] = m_int::encode<2>({-4, 2});
+
+  std::vector<m_int> out(v.size(), m_int::encode<2>({3, 3}));
+  const auto count = multipleint::compact_if(
+      std::execution::par_unseq, v.cbegin(), v.cend(), out.begin(), [](m_int x) { return x.in_range(0, 3); });
+
+  ASSERT_EQ(5000, count);
+
+  // Only the 2 of v[4321] ends up as logical index 4321
+  for (std::size_t i = 0; i < count / 2; ++i)
+    ASSERT_EQ((std::array {1, (i == 2160) ? 2 : 1}), out[i].decode<2>());
+
+  // Words past the compacted integers are untouched
+  EXPECT_EQ((std::array {3, 3}), out[2500].decode<2>());
+}
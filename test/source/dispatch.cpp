@@ -0,0 +1,170 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/mialgorithm.hpp>
+#include <multipleint/mibatch.hpp>
+#include <multipleint/micpu.hpp>
+
+#include "test_words.hpp"
+
+// All instruction sets the CPU running the test supports
+static auto supported_isas() -> std::vector<multipleint::isa>
+{
+  using multipleint::isa;
+
+  std::vector<isa> isas;
+
+  for (auto target : {isa::scalar, isa::sse42, isa::avx2, isa::avx512}) {
+    if (target <= multipleint::best_isa())
+      isas.push_back(target);
+  }
+
+  return isas;
+}
+
+template<std::size_t BitWidth, typename BackingStorage>
+static void expect_kernels_match_scalar()
+{
+  using T = multipleint::multiple_int<BitWidth, BackingStorage>;
+  using namespace multipleint::detail;
+
+  const auto x = test_words<T>(1000 + 3, 7);
+  const auto y = test_words<T>(1000 + 5, 5);
+
+  for (auto target : supported_isas()) {
+    SCOPED_TRACE(static_cast<int>(target));
+
+    std::vector<T> z(x.size());
+
+    _select_kernel<_batch_transform_kernel<_plus>, const T*, const T*, T*, std::size_t>(target)(
+        x.data(), y.data(), z.data(), x.size());
+
+    for (std::size_t i = 0; i < x.size(); ++i)
+      ASSERT_EQ(raw(x[i] + y[i]), raw(z[i]));
+
+    _select_kernel<_batch_transform_kernel<_maximum>, const T*, const T*, T*, std::size_t>(target)(
+        x.data(), y.data(), z.data(), x.size());
+
+    for (std::size_t i = 0; i < x.size(); ++i)
+      ASSERT_EQ(raw(max(x[i], y[i])), raw(z[i]));
+
+    auto sum = T {};
+    auto expected_sum = T {};
+
+    _select_kernel<_batch_reduce_kernel<_plus>, const T*, std::size_t, T*>(target)(x.data(), x.size(), &sum);
+
+    for (const auto& word : x)
+      expected_sum = expected_sum + word;
+
+    // The carry bits depend on the order of the additions
+    EXPECT_EQ(expected_sum.intv(), sum.intv());
+
+    auto maximum = std::numeric_limits<T>::lowest();
+    auto expected_maximum = std::numeric_limits<T>::lowest();
+
+    _select_kernel<_batch_reduce_kernel<_maximum>, const T*, std::size_t, T*>(target)(
+        x.data(), x.size(), &maximum);
+
+    for (const auto& word : x)
+      expected_maximum = max(expected_maximum, word);
+
+    EXPECT_EQ(expected_maximum.intv(), maximum.intv());
+  }
+}
+
+TEST(Dispatch, BatchKernels)
+{
+  expect_kernels_match_scalar<7, std::uint64_t>();
+  expect_kernels_match_scalar<16, std::uint64_t>();
+  expect_kernels_match_scalar<15, std::uint32_t>();
+  expect_kernels_match_scalar<3, std::uint8_t>();
+  expect_kernels_match_scalar<31, std::uint64_t>();
+}
+
+template<std::size_t BitWidth, typename BackingStorage>
+static void expect_conversions_match_scalar()
+{
+  using T = multipleint::multiple_int<BitWidth, BackingStorage>;
+  using namespace multipleint::detail;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+  constexpr int lowest = -(1 << (BitWidth - 1));
+
+  std::vector<std::int32_t> in(int_count * 1001);
+
+  for (std::size_t i = 0; i < in.size(); ++i)
+    in[i] = lowest + static_cast<int>(i % (std::size_t {1} << BitWidth));
+
+  std::vector<T> expected(in.size() / int_count);
+  _encode_words(in.data(), expected.data(), expected.size());
+
+  for (auto target : supported_isas()) {
+    SCOPED_TRACE(static_cast<int>(target));
+
+    std::vector<T> packed(expected.size());
+    _select_kernel<_encode_kernel, const std::int32_t*, T*, std::size_t>(target)(
+        in.data(), packed.data(), packed.size());
+
+    for (std::size_t i = 0; i < packed.size(); ++i)
+      ASSERT_EQ(raw(expected[i]), raw(packed[i]));
+
+    // The carry bits are ignored
+    for (std::size_t i = 0; i < packed.size(); i += 2)
+      packed[i] = packed[i] + std::numeric_limits<T>::max() + std::numeric_limits<T>::max();
+
+    std::vector<std::int32_t> out(in.size());
+    _select_kernel<_decode_kernel, const T*, std::int32_t*, std::size_t>(target)(
+        packed.data(), out.data(), packed.size());
+
+    for (std::size_t i = 0; i < in.size(); i += int_count) {
+      const auto word = packed[i / int_count].template decode<int_count>();
+
+      ASSERT_TRUE(std::equal(word.begin(), word.end(), out.begin() + static_cast<std::ptrdiff_t>(i)));
+    }
+  }
+}
+
+TEST(Dispatch, BulkConversionKernels)
+{
+  expect_conversions_match_scalar<7, std::uint64_t>();
+  expect_conversions_match_scalar<15, std::uint32_t>();
+  expect_conversions_match_scalar<31, std::uint64_t>();
+  expect_conversions_match_scalar<7, std::uint8_t>();
+  expect_conversions_match_scalar<9, std::uint64_t>();
+}
+
+TEST(Dispatch, ArrayAlgorithms)
+{
+  using m_int = multipleint::multiple_int<7, std::uint64_t>;
+
+  // More than one block of words
+  std::vector<m_int> x(10000, m_int::broadcast(1));
+  std::vector<m_int> y(10000, m_int::broadcast(2));
+  std::vector<m_int> z(10000);
+
+  x[1234] = m_int::broadcast(50);
+
+  multipleint::xpy(std::execution::par_unseq, std::span<const m_int>(x), std::span<const m_int>(y), std::span(z));
+
+  EXPECT_EQ(m_int::broadcast(3).decode<8>(), z.front().decode<8>());
+  EXPECT_EQ(m_int::broadcast(52).decode<8>(), z[1234].decode<8>());
+
+  multipleint::elemwise_max(
+      std::execution::par_unseq, std::span<const m_int>(x), std::span<const m_int>(y), std::span(z));
+
+  EXPECT_EQ(m_int::broadcast(2).decode<8>(), z.back().decode<8>());
+  EXPECT_EQ(m_int::broadcast(50).decode<8>(), z[1234].decode<8>());
+
+  const auto sum = multipleint::sum_red(std::execution::par_unseq, std::span<const m_int>(y).first(31), m_int {});
+  EXPECT_EQ(m_int::broadcast(62).decode<8>(), sum.decode<8>());
+
+  const auto maximum = multipleint::max_red(std::execution::par_unseq, std::span<const m_int>(x), m_int::broadcast(-3));
+  EXPECT_EQ(m_int::broadcast(50).decode<8>(), maximum.decode<8>());
+}
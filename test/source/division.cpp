@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+
+TEST(DivideBy, PowerOfTwo)
+{
+  using target_type = multipleint::multiple_int<7, std::uint32_t>;
+
+  constexpr auto num = target_type::encode<4>({13, -13, 63, -64});
+  constexpr auto res = num.divide_by<4>();
+  constexpr auto expected = target_type::encode<4>({3, -3, 15, -16});
+
+  EXPECT_EQ(expected.intv(), res.intv()) << "Expected " << std::hex << expected.intv() << ", got " << res.intv()
+                                         << "\n";
+  EXPECT_EQ(0, res.carry());
+}
+
+TEST(DivideBy, Reciprocal)
+{
+  {
+    using target_type = multipleint::multiple_int<7, std::uint64_t>;
+
+    constexpr auto num = target_type::encode<8>({0, 1, 2, 3, 63, -64, -1, -3});
+    constexpr auto res = num.divide_by<3>();
+    constexpr auto expected = target_type::encode<8>({0, 0, 0, 1, 21, -21, 0, -1});
+
+    EXPECT_EQ(expected.intv(), res.intv()) << "Expected " << std::hex << expected.intv() << ", got " << res.intv()
+                                           << "\n";
+    EXPECT_EQ(0, res.carry());
+  }
+
+  {
+    // Odd number of ints -> the topmost int is divided on its own
+    using target_type = multipleint::multiple_int<16, std::uint64_t>;
+
+    constexpr auto num = target_type::encode<3>({32767, -32768, -12345});
+    constexpr auto res = num.divide_by<10>();
+    constexpr auto expected = target_type::encode<3>({3276, -3276, -1234});
+
+    EXPECT_EQ(expected.intv(), res.intv()) << "Expected " << std::hex << expected.intv() << ", got " << res.intv()
+                                           << "\n";
+    EXPECT_EQ(0, res.carry());
+  }
+}
+
+TEST(DivideBy, AllValues)
+{
+  using target_type = multipleint::multiple_int<4, std::uint16_t>;
+
+  for (int i = -8; i < 8; ++i) {
+    const auto num = target_type::encode<3>({i, -i - 1, i / 2});
+
+    EXPECT_EQ((std::array<int, 3> {i / 5, (-i - 1) / 5, (i / 2) / 5}), num.divide_by<5>().decode<3>());
+    EXPECT_EQ((std::array<int, 3> {i % 5, (-i - 1) % 5, (i / 2) % 5}), num.mod_by<5>().decode<3>());
+  }
+}
+
+TEST(ModBy, SignOfDividend)
+{
+  using target_type = multipleint::multiple_int<15, std::uint64_t>;
+
+  constexpr auto num = target_type::encode<4>({17, -17, 15, -16384});
+  constexpr auto res = num.mod_by<5>();
+  constexpr auto expected = target_type::encode<4>({2, -2, 0, -4});
+
+  EXPECT_EQ(expected.intv(), res.intv()) << "Expected " << std::hex << expected.intv() << ", got " << res.intv()
+                                         << "\n";
+  EXPECT_EQ(0, res.carry());
+}
+
+TEST(ModBy, KeepsCarries)
+{
+  using target_type = multipleint::multiple_int<3, std::uint8_t>;
+
+  constexpr auto num = target_type::encode<2>({2, 2});
+  constexpr auto overflown = num + num;  // 4 does not fit into 3 bits
+  constexpr auto res = overflown.mod_by<3>();
+
+  EXPECT_EQ(overflown.carry(), res.carry());
+}
@@ -118,3 +118,32 @@ TEST(Encoding, Truncating)
     EXPECT_EQ(0, mi.carry());
   }
 }
+
+TEST(Encoding, PackedArrayAtCompileTime)
+{
+  using T = multipleint::multiple_int<7, std::uint32_t>;
+
+  // Four words, the last one holds a single integer
+  static constexpr auto table = multipleint::make_packed_array<7, std::uint32_t>(
+      std::array {1, -2, 3, -4, 63, -64, 0, 5, -1, -63, 62, 42, 9});
+
+  static_assert(table.size() == 4);
+  static_assert(table[0].decode<4>() == std::array {1, -2, 3, -4});
+  static_assert(table[1].decode<4>() == std::array {63, -64, 0, 5});
+  static_assert(table[2].decode<4>() == std::array {-1, -63, 62, 42});
+  static_assert(table[3].decode<4>() == std::array {9, 0, 0, 0});
+
+  // Negative values are sign-extended into their lanes only, the other lanes and the carry bits stay clear
+  static constexpr auto negative = multipleint::make_packed_array<7, std::uint32_t>(std::array {-64});
+
+  static_assert(negative[0].decode<4>() == std::array {-64, 0, 0, 0});
+  static_assert(negative[0].carry() == 0);
+
+  // Values out of range, e.g. make_packed_array<7, std::uint32_t>(std::array {64}), do not compile
+
+  EXPECT_EQ(T::encode<4>({1, -2, 3, -4}).intv(), table[0].intv());
+  EXPECT_EQ(0, table[2].carry());
+
+  static_assert(multipleint::make_packed_array<3, std::uint64_t>(std::array<int, 0> {}).empty());
+  static_assert(multipleint::make_packed_array<3, std::uint64_t>(std::array {1, 2, 3}).size() == 1);
+}
@@ -0,0 +1,85 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/micpu.hpp>
+#include <multipleint/miexpr.hpp>
+#include <multipleint/milimits.hpp>
+
+#include "test_words.hpp"
+
+template<std::size_t BitWidth, typename BackingStorage>
+static void expect_fused_matches_word_by_word()
+{
+  using T = multipleint::multiple_int<BitWidth, BackingStorage>;
+  using multipleint::lazy;
+
+  // More than one block of the parallel algorithms, no multiple of any batch size
+  constexpr std::size_t words = 5000 + 3;
+
+  const auto x = test_words<T>(words, 7);
+  const auto y = test_words<T>(words, 5);
+  const auto w = test_words<T>(words, 3);
+  const auto c = T::broadcast(3);
+
+  std::vector<T> z(words);
+
+  multipleint::evaluate(std::execution::par_unseq, std::span {z}, lazy(x) + lazy(y) - lazy(w));
+
+  for (std::size_t i = 0; i < words; ++i)
+    ASSERT_EQ(raw(x[i] + y[i] - w[i]), raw(z[i])) << i;
+
+  multipleint::evaluate(std::execution::par_unseq, std::span {z}, max(lazy(x) + lazy(y), lazy(w)));
+
+  for (std::size_t i = 0; i < words; ++i)
+    ASSERT_EQ(raw(max(x[i] + y[i], w[i])), raw(z[i])) << i;
+
+  multipleint::evaluate(std::execution::seq, std::span {z}, -(lazy(x) - lazy(c)) + max(lazy(y), -lazy(w)));
+
+  for (std::size_t i = 0; i < words; ++i)
+    ASSERT_EQ(raw(-(x[i] - c) + max(y[i], -w[i])), raw(z[i])) << i;
+
+  // Every instruction set the CPU supports
+  const auto fused = max(lazy(x) - lazy(y), lazy(w) + lazy(c));
+
+  for (auto target : {multipleint::isa::scalar, multipleint::isa::sse42, multipleint::isa::avx2}) {
+    if (target > multipleint::best_isa())
+      continue;
+
+    std::vector<T> out(words);
+
+    multipleint::detail::_select_kernel<multipleint::detail::_expr_kernel,
+                                        const decltype(fused)*,
+                                        T*,
+                                        std::size_t,
+                                        std::size_t>(target)(&fused, out.data(), 0, words);
+
+    for (std::size_t i = 0; i < words; ++i)
+      ASSERT_EQ(raw(max(x[i] - y[i], w[i] + c)), raw(out[i])) << static_cast<int>(target) << " " << i;
+  }
+
+  // z may be an operand as well
+  auto expected = z;
+
+  for (std::size_t i = 0; i < words; ++i)
+    expected[i] = expected[i] + x[i];
+
+  multipleint::evaluate(std::execution::par_unseq, std::span {z}, lazy(z) + lazy(x));
+
+  for (std::size_t i = 0; i < words; ++i)
+    ASSERT_EQ(raw(expected[i]), raw(z[i])) << i;
+}
+
+TEST(Expression, FusedMatchesWordByWord)
+{
+  expect_fused_matches_word_by_word<7, std::uint64_t>();
+  expect_fused_matches_word_by_word<16, std::uint64_t>();
+  expect_fused_matches_word_by_word<15, std::uint32_t>();
+  expect_fused_matches_word_by_word<3, std::uint8_t>();
+}
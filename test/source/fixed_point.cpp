@@ -0,0 +1,128 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/mifixed.hpp>
+
+// 12-bit samples from [-1, 1)
+using q11 = multipleint::packed_fixed<1, 11, std::uint64_t>;
+
+TEST(FixedPoint, Floats)
+{
+  static_assert(q11::IntCount == 4);
+
+  constexpr auto x = q11::from_float({0.5f, -1.0f, 0.25f + 1.0f / 2048, -0.75f});
+
+  static_assert(x.bits().decode<4>() == std::array {1024, -2048, 513, -1536});
+  static_assert(x.to_float() == std::array {0.5f, -1.0f, 0.25f + 1.0f / 2048, -0.75f});
+
+  // Rounded to nearest, ties away from zero, clamped to [-1, 1 - 2^-11]
+  const auto y = q11::from_float({1.5f / 2048, -1.5f / 2048, 0.4f / 2048, 1.0f});
+
+  ASSERT_EQ((std::array {2, -2, 0, 2047}), y.bits().decode<4>());
+  ASSERT_EQ(0, y.carry());
+
+  const auto z = q11::from_float({-7.0f, std::numeric_limits<float>::infinity(), std::nanf(""), 1.0f / 2048});
+
+  ASSERT_EQ((std::array {-2048, 2047, 0, 1}), z.bits().decode<4>());
+
+  ASSERT_EQ((std::array {-0.25f, -0.25f, -0.25f, -0.25f}), q11::broadcast(-0.25f).to_float());
+}
+
+TEST(FixedPoint, AdditionIsTheOneOfMultipleInt)
+{
+  const auto x = q11::from_float({0.5f, -1.0f, 0.75f, -0.5f});
+  const auto y = q11::from_float({0.25f, -0.5f, 0.5f, 0.25f});
+
+  ASSERT_EQ((x.bits() + y.bits()).carry(), (x + y).carry());
+  ASSERT_EQ((std::array {0.75f, 0.5f, -0.75f, -0.25f}), (x + y).to_float());
+  ASSERT_EQ((std::array {0.25f, -0.5f, 0.25f, -0.75f}), (x - y).to_float());
+  ASSERT_EQ((std::array {-0.5f, -1.0f, -0.75f, 0.5f}), (-x).to_float());
+  ASSERT_EQ((std::array {0.5f, -0.5f, 0.75f, 0.25f}), max(x, y).to_float());
+  ASSERT_EQ((std::array {0.25f, -1.0f, 0.5f, -0.5f}), min(x, y).to_float());
+}
+
+template<std::size_t IntBits, std::size_t FracBits, typename BackingStorage>
+static void expect_products_rounded()
+{
+  using T = multipleint::packed_fixed<IntBits, FracBits, BackingStorage>;
+
+  constexpr auto bit_width = IntBits + FracBits;
+  constexpr auto min = -(1 << (bit_width - 1));
+  constexpr auto max = (1 << (bit_width - 1)) - 1;
+  constexpr auto lanes = static_cast<std::size_t>(T::IntCount);
+
+  const auto lane_value = [](std::int64_t v) { return static_cast<int>(((v - min) & ((1 << bit_width) - 1)) + min); };
+
+  for (int a = min; a <= max; a += (bit_width > 10 ? 3 : 1)) {
+    std::array<int, lanes> lhs {};
+    std::array<int, lanes> rhs {};
+
+    for (int b = min; b <= max; b += static_cast<int>(lanes)) {
+      for (std::size_t i = 0; i < lanes; ++i) {
+        lhs[i] = a;
+        rhs[i] = std::min(b + static_cast<int>(i), max);
+      }
+
+      const auto product = T {T::int_type::encode(lhs)} * T {T::int_type::encode(rhs)};
+      const auto result = product.bits().template decode<lanes>();
+
+      for (std::size_t i = 0; i < lanes; ++i) {
+        // Round to nearest, ties up
+        const auto expected = static_cast<std::int64_t>(
+            std::floor(static_cast<double>(lhs[i]) * rhs[i] / static_cast<double>(1 << FracBits) + 0.5));
+        const auto overflow = expected < min || expected > max;
+
+        ASSERT_EQ(lane_value(expected), result[i]) << lhs[i] << " * " << rhs[i];
+        ASSERT_EQ(overflow, ((product.carry() >> (i * (bit_width + 1) + bit_width)) & 1) != 0) << lhs[i] << " * "
+                                                                                                 << rhs[i];
+      }
+    }
+  }
+}
+
+TEST(FixedPoint, RoundingMultiply)
+{
+  expect_products_rounded<1, 11, std::uint64_t>();
+  expect_products_rounded<1, 11, std::uint32_t>();
+  expect_products_rounded<4, 8, std::uint64_t>();
+  expect_products_rounded<1, 7, std::uint32_t>();
+  expect_products_rounded<2, 4, std::uint16_t>();
+  expect_products_rounded<3, 0, std::uint8_t>();
+
+  // Carry bits of the operands are kept
+  const auto carries = q11::from_float({-1.0f, 0, 0, 0}) + q11::from_float({-1.0f, 0, 0, 0});
+  const auto product = carries * q11::broadcast(0.5f);
+
+  ASSERT_EQ(carries.carry(), product.carry());
+  ASSERT_EQ((std::array {0.0f, 0.0f, 0.0f, 0.0f}), product.to_float());
+}
+
+TEST(FixedPoint, Rescale)
+{
+  const auto x = q11::from_float({0.75f, -0.5f, 3.0f / 2048, -3.0f / 2048});
+
+  // Fewer fraction bits round to nearest, ties up
+  const auto coarse = x.rescale<9>();
+
+  static_assert(std::is_same_v<decltype(coarse), const multipleint::packed_fixed<3, 9, std::uint64_t>>);
+
+  ASSERT_EQ((std::array {384, -256, 1, -1}), coarse.bits().decode<4>());
+  ASSERT_EQ(0, coarse.carry());
+
+  // More fraction bits can overflow
+  const auto y = multipleint::packed_fixed<4, 8, std::uint64_t>::from_float({0.5f, -1.0f, 3.0f, -2.5f});
+  const auto fine = y.rescale<10>();
+
+  ASSERT_EQ((std::array {0.5f, -1.0f, -1.0f, 1.5f}), fine.to_float());
+  ASSERT_EQ(0U, (fine.carry() >> 12) & 1);
+  ASSERT_EQ(0U, (fine.carry() >> 25) & 1);
+  ASSERT_EQ(1U, (fine.carry() >> 38) & 1);
+  ASSERT_EQ(1U, (fine.carry() >> 51) & 1);
+}
@@ -0,0 +1,155 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/miframe.hpp>
+
+TEST(FrameOfReference, BitWidth)
+{
+  EXPECT_EQ(1, multipleint::for_bit_width(5, 5));
+  EXPECT_EQ(1, multipleint::for_bit_width(5, 6));
+  EXPECT_EQ(8, multipleint::for_bit_width(-100, 155));
+  EXPECT_EQ(9, multipleint::for_bit_width(-100, 156));
+  EXPECT_EQ(64, multipleint::for_bit_width(std::numeric_limits<std::int64_t>::lowest(), 0));
+}
+
+TEST(FrameOfReference, EncodeDecode)
+{
+  using block = multipleint::for_block<7, std::uint64_t, 4>;
+
+  // Timestamps with a range of 127
+  std::vector<std::int64_t> values(block::size - 3);
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = 1'700'000'000'000 + static_cast<std::int64_t>((i * 37) % 128);
+
+  const auto packed = block::encode(values);
+  ASSERT_TRUE(packed.has_value());
+
+  std::vector<std::int64_t> out(values.size());
+  packed->decode(out);
+
+  EXPECT_EQ(values, out);
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), std::int64_t {0}), packed->sum());
+  EXPECT_EQ(*std::max_element(values.begin(), values.end()), packed->max());
+
+  // A range of 128 needs 8 bits
+  values.back() = 1'700'000'000'128;
+  EXPECT_FALSE(block::encode(values).has_value());
+
+  // At most size values
+  values.back() = 1'700'000'000'000;
+  values.resize(block::size, 1'700'000'000'000);
+  EXPECT_TRUE(block::encode(values).has_value());
+
+  values.push_back(1'700'000'000'000);
+  EXPECT_FALSE(block::encode(values).has_value());
+
+  using single_word = multipleint::for_block<7, std::uint64_t, 1>;
+  EXPECT_FALSE(single_word::encode(std::vector<std::int64_t>(20)).has_value());
+}
+
+template<std::size_t BitWidth>
+concept valid_for_block = requires { typename multipleint::for_block<BitWidth, std::uint64_t, 2>; };
+
+TEST(FrameOfReference, WidestOffsets)
+{
+  // The offsets are ints
+  static_assert(valid_for_block<32>);
+  static_assert(!valid_for_block<33>);
+  static_assert(!valid_for_block<40>);
+
+  using block = multipleint::for_block<32, std::uint64_t, 2>;
+
+  const std::vector<std::int64_t> values {-(std::int64_t {1} << 40), -(std::int64_t {1} << 40) + 0xffff'ffff};
+
+  const auto packed = block::encode(values);
+  ASSERT_TRUE(packed.has_value());
+
+  std::vector<std::int64_t> out(2);
+  packed->decode(out);
+
+  EXPECT_EQ(values, out);
+  EXPECT_EQ(values[0] + values[1], packed->sum());
+  EXPECT_EQ(values[1], packed->max());
+
+  // A range of 2^32 needs 33 bits
+  EXPECT_FALSE(block::encode(std::vector {values[0], values[0] + (std::int64_t {1} << 32)}).has_value());
+}
+
+TEST(FrameOfReference, Extremes)
+{
+  using block = multipleint::for_block<3, std::uint16_t, 2>;
+
+  constexpr auto highest = std::numeric_limits<std::int64_t>::max();
+  constexpr auto lowest = std::numeric_limits<std::int64_t>::lowest();
+
+  for (const auto& values : {std::vector<std::int64_t> {highest, highest - 7, highest - 3},
+                             std::vector<std::int64_t> {lowest, lowest + 7, lowest + 1}})
+  {
+    const auto packed = block::encode(values);
+    ASSERT_TRUE(packed.has_value());
+
+    std::vector<std::int64_t> out(values.size());
+    packed->decode(out);
+
+    EXPECT_EQ(values, out);
+    EXPECT_EQ(*std::max_element(values.begin(), values.end()), packed->max());
+
+    std::vector<std::uint64_t> bitmap(1);
+    multipleint::range_scan(
+        std::execution::seq, std::span<const block>(&*packed, 1), lowest, highest, std::span {bitmap});
+    EXPECT_EQ(0b111, bitmap[0]);
+
+    multipleint::range_scan(
+        std::execution::seq, std::span<const block>(&*packed, 1), values[2], values[2], std::span {bitmap});
+    EXPECT_EQ(0b100, bitmap[0]);
+  }
+}
+
+TEST(FrameOfReference, ArrayAlgorithms)
+{
+  // 6 integers per word, blocks of 18 values, which do not line up with the bitmap words
+  using block = multipleint::for_block<9, std::uint64_t, 3>;
+
+  std::vector<std::int64_t> values(1000);
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = static_cast<std::int64_t>(i) * 10 + static_cast<std::int64_t>((i * 7919) % 7) - 1'000'000;
+
+  std::vector<block> blocks;
+
+  for (std::size_t first = 0; first < values.size(); first += block::size) {
+    const auto count = std::min(block::size, values.size() - first);
+
+    // The values within a block differ by at most 17 * 10 + 6
+    const auto packed = block::encode(std::span<const std::int64_t>(values).subspan(first, count));
+    ASSERT_TRUE(packed.has_value());
+
+    blocks.push_back(*packed);
+  }
+
+  const std::span<const block> view(blocks);
+
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), std::int64_t {0}),
+            multipleint::sum_red(std::execution::par_unseq, view));
+  EXPECT_EQ(*std::max_element(values.begin(), values.end()), multipleint::max_red(std::execution::par_unseq, view));
+
+  for (const auto& [lo, hi] : {std::pair<std::int64_t, std::int64_t> {-996'000, -994'000},
+                               std::pair<std::int64_t, std::int64_t> {-1'000'000, -999'980},
+                               std::pair<std::int64_t, std::int64_t> {-995'555, -995'555},
+                               std::pair<std::int64_t, std::int64_t> {-2'000'000, 2'000'000}})
+  {
+    std::vector<std::uint64_t> bitmap((blocks.size() * block::size + 63) / 64, ~std::uint64_t {0});
+    multipleint::range_scan(std::execution::par_unseq, view, lo, hi, std::span {bitmap});
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+      ASSERT_EQ(lo <= values[i] && values[i] <= hi, (bitmap[i / 64] >> (i % 64)) & 1) << i;
+  }
+}
@@ -0,0 +1,164 @@
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/mihetero.hpp>
+
+#include "test_words.hpp"
+
+// Lane Index of a hetero_int as the first lane of the multiple_int of the same width (value and carry bit)
+template<std::size_t Index, class T>
+static auto as_multiple_int(T value)
+{
+  constexpr auto width = T::template bit_width<Index>;
+  constexpr auto offset = T::traits::offsets[Index];
+
+  using R = multipleint::multiple_int<width, std::uint64_t>;
+
+  const auto lane = (static_cast<std::uint64_t>(raw(value)) >> offset) & ((std::uint64_t {2} << width) - 1);
+
+  return multipleint::detail::_multiple_int_access::make<R>(lane);
+}
+
+// Every lane of the results is the first lane of the same operation on the multiple_int of its width
+template<class T>
+static void expect_lanes_match(T lhs, T rhs)
+{
+  [&]<std::size_t... Idx>(std::index_sequence<Idx...>)
+  {
+    const auto expect_lane = [&]<std::size_t Index>(std::integral_constant<std::size_t, Index>)
+    {
+      const auto l = as_multiple_int<Index>(lhs);
+      const auto r = as_multiple_int<Index>(rhs);
+
+      ASSERT_EQ(raw(l + r), raw(as_multiple_int<Index>(lhs + rhs))) << Index;
+      ASSERT_EQ(raw(l - r), raw(as_multiple_int<Index>(lhs - rhs))) << Index;
+      ASSERT_EQ(raw(-l), raw(as_multiple_int<Index>(-lhs))) << Index;
+      ASSERT_EQ(raw(max(l, r)), raw(as_multiple_int<Index>(max(lhs, rhs)))) << Index;
+      ASSERT_EQ(raw(min(l, r)), raw(as_multiple_int<Index>(min(lhs, rhs)))) << Index;
+    };
+
+    (expect_lane(std::integral_constant<std::size_t, Idx> {}), ...);
+  }(std::make_index_sequence<T::IntCount> {});
+}
+
+template<class T>
+static void expect_hetero_arithmetic()
+{
+  using storage = decltype(T {}.intv());
+
+  // The edge values of every width in all lanes at once
+  constexpr std::array<int, 7> edges {-2, -1, 0, 1, 2, 3, 4};
+
+  for (auto l : edges) {
+    for (auto r : edges) {
+      const auto values = [](int edge)
+      {
+        std::array<int, T::IntCount> result {};
+
+        [&]<std::size_t... Idx>(std::index_sequence<Idx...>)
+        {
+          // min, -1, 0, 1, max - 2, max - 1, max (truncated to the narrowest widths)
+          const auto value = [edge](std::size_t width)
+          {
+            const auto min = -(std::int64_t {1} << (width - 1));
+            const auto max = (std::int64_t {1} << (width - 1)) - 1;
+
+            return static_cast<int>(edge < -1 ? min : (edge > 1 ? max - (4 - edge) : edge));
+          };
+
+          ((result[Idx] = value(T::template bit_width<Idx>)), ...);
+        }(std::make_index_sequence<T::IntCount> {});
+
+        return result;
+      };
+
+      const auto lhs = T::encode(values(l));
+      const auto rhs = T::encode(values(r));
+
+      expect_lanes_match(lhs, rhs);
+    }
+  }
+
+  // Pseudo-random words, about a quarter of the carry bits set
+  std::uint64_t state = 0x9e3779b97f4a7c15;
+
+  const auto next = [&state]()
+  {
+    state ^= state << 13;
+    state ^= state >> 7;
+    state ^= state << 17;
+    return static_cast<storage>(state);
+  };
+
+  for (int i = 0; i < 20000; ++i) {
+    const auto carries = static_cast<storage>(next() & next() & T::traits::carry_mask);
+    const auto lhs = std::bit_cast<T>(static_cast<storage>((next() & T::traits::int_mask) | carries));
+    const auto rhs = std::bit_cast<T>(static_cast<storage>(next() & T::traits::int_mask));
+
+    expect_lanes_match(lhs, rhs);
+    expect_lanes_match(rhs, lhs);
+  }
+}
+
+TEST(HeteroInt, Masks)
+{
+  using T = multipleint::hetero_int<std::uint64_t, 5, 11, 16, 28>;
+
+  static_assert(T::IntCount == 4);
+  static_assert(T::traits::offsets == std::array<std::size_t, 4> {0, 6, 18, 35});
+  static_assert(T::traits::carry_mask == ((1ULL << 5) | (1ULL << 17) | (1ULL << 34) | (1ULL << 63)));
+  static_assert(T::traits::sign_mask == T::traits::carry_mask >> 1);
+  static_assert(T::traits::int_mask == ~T::traits::carry_mask);
+  static_assert(T::traits::empty_mask == 0);
+
+  using U = multipleint::hetero_int<std::uint16_t, 3, 4>;
+
+  static_assert(U::traits::int_mask == 0b0'1111'0'111);
+  static_assert(U::traits::carry_mask == 0b1'0000'1'000);
+  static_assert(U::traits::empty_mask == 0b1111'1110'0000'0000);
+
+  constexpr auto word = T::encode({-16, 1023, -32768, (1 << 27) - 1});
+
+  static_assert(word.extract<0>() == -16);
+  static_assert(word.extract<1>() == 1023);
+  static_assert(word.extract<2>() == -32768);
+  static_assert(word.extract<3>() == (1 << 27) - 1);
+  static_assert(word.carry() == 0);
+}
+
+TEST(HeteroInt, MatchesMultipleIntPerLane)
+{
+  expect_hetero_arithmetic<multipleint::hetero_int<std::uint64_t, 5, 11, 16, 28>>();
+  expect_hetero_arithmetic<multipleint::hetero_int<std::uint64_t, 3, 7, 3, 12, 7, 3>>();
+  expect_hetero_arithmetic<multipleint::hetero_int<std::uint64_t, 1, 2, 1, 56>>();
+  expect_hetero_arithmetic<multipleint::hetero_int<std::uint32_t, 4, 10, 8>>();
+  expect_hetero_arithmetic<multipleint::hetero_int<std::uint16_t, 3, 4>>();
+  expect_hetero_arithmetic<multipleint::hetero_int<std::uint8_t, 2, 1, 2>>();
+}
+
+TEST(HeteroInt, WidenKeepsLanes)
+{
+  using T = multipleint::hetero_int<std::uint32_t, 4, 10, 8, 5>;
+  using U = decltype(widen(T {}));
+
+  static_assert(std::is_same_v<U, multipleint::hetero_int<std::uint64_t, 9, 21, 17, 11>>);
+
+  const auto max = T::encode({7, 511, 127, 15});
+  const auto values = std::array {T::encode({-8, -512, -128, -16}), T::encode({-1, 3, 0, 9}), max, max + max};
+
+  for (auto value : values) {
+    const auto wide = widen(value);
+
+    ASSERT_EQ(value.decode(), wide.decode());
+    ASSERT_EQ(0, wide.carry());
+  }
+
+  ASSERT_EQ((std::array {14, 1022, 254, 30}), (widen(max) + widen(max)).decode());
+}
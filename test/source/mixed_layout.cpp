@@ -0,0 +1,96 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/mibatch.hpp>
+#include <multipleint/micpu.hpp>
+#include <multipleint/miexpr.hpp>
+#include <multipleint/milimits.hpp>
+
+#include "test_words.hpp"
+
+template<std::size_t BitWidth, typename BackingStorage>
+static void expect_mixed_matches_widened()
+{
+  using T = multipleint::multiple_int<BitWidth, BackingStorage>;
+  using U = decltype(multipleint::widen(T {}));
+  using multipleint::lazy;
+  using multipleint::widen;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+  static_assert(T::IntCount == U::IntCount);
+
+  // More than one block of the parallel algorithms, no multiple of any batch size
+  constexpr std::size_t words = 5000 + 3;
+
+  const auto x = test_words<T>(words, 7);
+  const auto y = test_words<U>(words, 5);
+
+  // Lane k of x[i] is lane k of the widened word
+  for (std::size_t i = 0; i < words; ++i) {
+    ASSERT_EQ(x[i].template decode<int_count>(), widen(x[i]).template decode<int_count>()) << i;
+    ASSERT_EQ(0, widen(x[i]).carry()) << i;
+  }
+
+  std::vector<U> z(words);
+
+  multipleint::xpy(std::execution::par_unseq, std::span<const T> {x}, std::span<const U> {y}, std::span {z});
+
+  for (std::size_t i = 0; i < words; ++i)
+    ASSERT_EQ(raw(widen(x[i]) + y[i]), raw(z[i])) << i;
+
+  multipleint::elemwise_max(std::execution::par_unseq, std::span<const T> {x}, std::span<const U> {y}, std::span {z});
+
+  for (std::size_t i = 0; i < words; ++i)
+    ASSERT_EQ(raw(max(widen(x[i]), y[i])), raw(z[i])) << i;
+
+  // Every instruction set the CPU supports
+  using multipleint::isa;
+
+  for (auto target : {isa::scalar, isa::sse42, isa::avx2, isa::avx512}) {
+    if (target > multipleint::best_isa())
+      continue;
+
+    std::vector<U> out(words);
+
+    multipleint::detail::_select_kernel<multipleint::detail::_widening_transform_kernel<multipleint::detail::_plus>,
+                                        const T*,
+                                        const U*,
+                                        U*,
+                                        std::size_t>(target)(x.data(), y.data(), out.data(), words);
+
+    for (std::size_t i = 0; i < words; ++i)
+      ASSERT_EQ(raw(widen(x[i]) + y[i]), raw(out[i])) << static_cast<int>(target) << " " << i;
+  }
+
+  // Widened operands in expressions, in any position
+  const auto c = T::broadcast(-3);
+
+  multipleint::evaluate(
+      std::execution::par_unseq, std::span {z}, lazy(y) - widen(lazy(x)) + widen(max(lazy(x), lazy(c))));
+
+  for (std::size_t i = 0; i < words; ++i)
+    ASSERT_EQ(raw(y[i] - widen(x[i]) + widen(max(x[i], c))), raw(z[i])) << i;
+
+  multipleint::evaluate(std::execution::seq, std::span {z}, max(-widen(lazy(x)), lazy(y)));
+
+  for (std::size_t i = 0; i < words; ++i)
+    ASSERT_EQ(raw(max(-widen(x[i]), y[i])), raw(z[i])) << i;
+}
+
+TEST(MixedLayout, MatchesWidened)
+{
+  expect_mixed_matches_widened<7, std::uint32_t>();
+  expect_mixed_matches_widened<9, std::uint32_t>();
+  expect_mixed_matches_widened<4, std::uint32_t>();
+  expect_mixed_matches_widened<7, std::uint16_t>();
+  expect_mixed_matches_widened<3, std::uint8_t>();
+  expect_mixed_matches_widened<1, std::uint8_t>();
+}
@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/mibatch.hpp>
+#include <multipleint/micpu.hpp>
+
+template<std::size_t BitWidth, typename BackingStorage>
+static void expect_narrow_checks_every_lane()
+{
+  using T = multipleint::multiple_int<BitWidth, BackingStorage>;
+  using U = decltype(multipleint::widen(T {}));
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+  constexpr auto limit = std::int64_t {1} << (BitWidth - 1);
+  constexpr auto wide_limit = std::int64_t {1} << (2 * BitWidth);
+
+  // More than one block of the parallel algorithms, words which fit entirely in most groups of the kernels
+  constexpr std::size_t words = 9000 + 5;
+
+  std::vector<U> in(words);
+  std::vector<std::array<int, int_count>> values(words);
+
+  for (std::size_t w = 0; w < words; ++w) {
+    for (std::size_t i = 0; i < int_count; ++i) {
+      const auto n = static_cast<std::int64_t>(w * int_count + i);
+
+      // Values around both bounds, and some far out of range
+      values[w][i] = static_cast<int>((w % 97 == 3) ? (n * 7919) % (2 * wide_limit) - wide_limit
+                                                    : (n * 31) % (2 * limit + 4) - limit - 2);
+    }
+
+    in[w] = U::encode(values[w]);
+  }
+
+  for (auto mode : {multipleint::narrow_mode::truncate, multipleint::narrow_mode::saturate}) {
+    std::vector<T> out(words);
+    std::vector<std::uint64_t> bitmap((words * int_count + 63) / 64, ~std::uint64_t {0});
+
+    const auto count = multipleint::narrow(
+        std::execution::par_unseq, std::span<const U> {in}, std::span {out}, std::span {bitmap}, mode);
+
+    std::size_t expected_count = 0;
+
+    for (std::size_t w = 0; w < words; ++w) {
+      const auto actual = out[w].template decode<int_count>();
+
+      for (std::size_t i = 0; i < int_count; ++i) {
+        const auto value = static_cast<std::int64_t>(values[w][i]);
+        const auto fits = -limit <= value && value < limit;
+        const auto position = w * int_count + i;
+
+        std::int64_t expected = std::clamp(value, -limit, limit - 1);
+
+        if (mode == multipleint::narrow_mode::truncate)
+          expected = ((value & (2 * limit - 1)) ^ limit) - limit;
+
+        expected_count += fits ? 0 : 1;
+
+        ASSERT_EQ(expected, actual[i]) << w << " " << i;
+        ASSERT_EQ(!fits, ((bitmap[position / 64] >> (position % 64)) & 1) != 0) << w << " " << i;
+      }
+
+      ASSERT_EQ(0, out[w].carry()) << w;
+    }
+
+    // The bits past the last integer are cleared as well
+    if ((words * int_count) % 64 != 0) {
+      EXPECT_EQ(0, bitmap.back() >> ((words * int_count) % 64));
+    }
+
+    EXPECT_EQ(expected_count, count);
+
+    std::vector<T> without_bitmap(words);
+
+    EXPECT_EQ(count,
+              multipleint::narrow(std::execution::seq, std::span<const U> {in}, std::span {without_bitmap}, mode));
+
+    for (std::size_t w = 0; w < words; ++w)
+      ASSERT_EQ(out[w].intv(), without_bitmap[w].intv()) << w;
+  }
+
+  // Every instruction set the CPU supports
+  using multipleint::isa;
+
+  for (auto target : {isa::scalar, isa::sse42, isa::avx2, isa::avx512}) {
+    if (target > multipleint::best_isa())
+      continue;
+
+    std::vector<T> out(words);
+    std::size_t count = 0;
+
+    multipleint::detail::_select_kernel<multipleint::detail::_narrow_kernel<true>,
+                                        const U*,
+                                        T*,
+                                        std::size_t,
+                                        std::uint64_t*,
+                                        std::size_t*>(target)(in.data(), out.data(), words, nullptr, &count);
+
+    for (std::size_t w = 0; w < words; ++w) {
+      for (std::size_t i = 0; i < int_count; ++i) {
+        const auto value = static_cast<std::int64_t>(values[w][i]);
+
+        ASSERT_EQ(std::clamp(value, -limit, limit - 1), out[w].template decode<int_count>()[i])
+            << static_cast<int>(target) << " " << w;
+      }
+    }
+  }
+}
+
+TEST(Narrow, ChecksEveryLane)
+{
+  expect_narrow_checks_every_lane<7, std::uint32_t>();
+  expect_narrow_checks_every_lane<9, std::uint32_t>();
+  expect_narrow_checks_every_lane<4, std::uint32_t>();
+  expect_narrow_checks_every_lane<15, std::uint16_t>();
+  expect_narrow_checks_every_lane<3, std::uint8_t>();
+  expect_narrow_checks_every_lane<1, std::uint8_t>();
+}
+
+TEST(Narrow, InverseOfWiden)
+{
+  using T = multipleint::multiple_int<7, std::uint32_t>;
+  using U = multipleint::multiple_int<15, std::uint64_t>;
+
+  const std::vector<T> words {T::encode<4>({-64, 63, 0, -1}), T::encode<4>({1, 2, 3, 4}), T::broadcast(-7)};
+
+  std::vector<U> wide(words.size());
+
+  for (std::size_t w = 0; w < words.size(); ++w)
+    wide[w] = multipleint::widen(words[w]);
+
+  std::vector<T> narrowed(words.size());
+
+  EXPECT_EQ(0, multipleint::narrow(std::execution::seq, std::span<const U> {wide}, std::span {narrowed}));
+
+  for (std::size_t w = 0; w < words.size(); ++w)
+    EXPECT_EQ(words[w].intv(), narrowed[w].intv()) << w;
+}
@@ -0,0 +1,111 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mialgorithm.hpp>
+#include <multipleint/mivector.hpp>
+
+using vector_type = multipleint::packed_vector<5, std::uint64_t>;
+
+static_assert(std::random_access_iterator<vector_type::iterator>);
+static_assert(std::random_access_iterator<vector_type::const_iterator>);
+static_assert(std::indirectly_writable<vector_type::iterator, int>);
+static_assert(std::sortable<vector_type::iterator>);
+static_assert(std::ranges::random_access_range<vector_type>);
+
+TEST(PackedVector, PushBack)
+{
+  // 10 integers per word
+  vector_type v;
+  std::vector<int> expected;
+
+  for (int i = 0; i < 95; ++i) {
+    v.push_back(i % 32 - 16);
+    expected.push_back(i % 32 - 16);
+  }
+
+  ASSERT_EQ(95, v.size());
+  EXPECT_EQ(10, v.words().size());
+  EXPECT_GE(v.capacity(), v.size());
+  EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+
+  // The unused lanes of the last word are zero
+  EXPECT_EQ((std::array<int, 10> {10, 11, 12, 13, 14, 0, 0, 0, 0, 0}), v.words().back().decode<10>());
+
+  // Values are truncated to 5 bits like integer conversions
+  v[3] = 17;
+  v.back() = -17;
+  EXPECT_EQ(-15, v[3]);
+  EXPECT_EQ(15, v[94]);
+
+  v[4] += 3;
+  EXPECT_EQ(-9, v[4]);
+
+  v.pop_back();
+  EXPECT_EQ(94, v.size());
+  EXPECT_EQ(13, v.back());
+  EXPECT_EQ(0, v.words().back().extract<4>());
+}
+
+TEST(PackedVector, Resize)
+{
+  vector_type v(23, -3);
+
+  EXPECT_EQ(23, v.size());
+  EXPECT_EQ(3, v.words().size());
+  EXPECT_EQ(23, std::count(v.begin(), v.end(), -3));
+  EXPECT_EQ(23, multipleint::count_equal(std::execution::seq, v.words().begin(), v.words().end(), -3));
+
+  v.resize(7);
+  EXPECT_EQ(1, v.words().size());
+  EXPECT_EQ(7, multipleint::count_equal(std::execution::seq, v.words().begin(), v.words().end(), -3));
+
+  v.resize(42, 5);
+  EXPECT_EQ(vector_type({-3, -3, -3, -3, -3, -3, -3, 5, 5, 5}), vector_type(v.begin(), v.begin() + 10));
+  EXPECT_EQ(35, std::count(v.begin(), v.end(), 5));
+
+  v.clear();
+  EXPECT_TRUE(v.empty());
+  EXPECT_EQ(v.begin(), v.end());
+}
+
+TEST(PackedVector, Algorithms)
+{
+  vector_type v;
+
+  for (int i = 0; i < 200; ++i)
+    v.push_back((i * 7919) % 31 - 15);
+
+  std::vector<int> expected(v.begin(), v.end());
+
+  EXPECT_EQ(std::accumulate(expected.begin(), expected.end(), 0), std::accumulate(v.begin(), v.end(), 0));
+
+  std::sort(v.begin(), v.end());
+  std::sort(expected.begin(), expected.end());
+  EXPECT_TRUE(std::equal(v.begin(), v.end(), expected.begin(), expected.end()));
+
+  std::ranges::reverse(v);
+  std::ranges::reverse(expected);
+  EXPECT_TRUE(std::ranges::equal(v, expected));
+
+  const auto& cv = v;
+  EXPECT_EQ(expected[57], cv.begin()[57]);
+  EXPECT_EQ(200, cv.end() - cv.begin());
+
+  vector_type::const_iterator it = v.begin();
+  EXPECT_EQ(cv.begin(), it);
+
+  // The words work with the array algorithms
+  std::vector<std::int32_t> decoded(v.size());
+  const std::span<const vector_type::word_type> words = v.words();
+
+  multipleint::decode_bulk(std::execution::seq, words, std::span {decoded});
+  EXPECT_TRUE(std::ranges::equal(expected, decoded));
+}
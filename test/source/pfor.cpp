@@ -0,0 +1,136 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mipfor.hpp>
+
+TEST(PatchedFrameOfReference, BitWidths)
+{
+  EXPECT_EQ((std::array<std::size_t, 13> {1, 2, 3, 4, 5, 6, 7, 8, 9, 11, 15, 20, 31}),
+            multipleint::pfor_array<std::uint64_t>::bit_widths);
+  EXPECT_EQ((std::array<std::size_t, 6> {1, 2, 3, 4, 7, 15}), multipleint::pfor_array<std::uint16_t>::bit_widths);
+}
+
+TEST(PatchedFrameOfReference, Outliers)
+{
+  using array_type = multipleint::pfor_array<std::uint64_t, 128>;
+
+  // Values with a range of 100 and an outlier every 50 values
+  std::vector<std::int64_t> values(1000);
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = (i % 50 == 7) ? 5'000'000 * static_cast<std::int64_t>(i) : 1000 + static_cast<std::int64_t>(i % 101);
+
+  const auto packed = array_type::encode(values);
+
+  ASSERT_EQ(values.size(), packed.size());
+  ASSERT_EQ(8, packed.block_count());
+
+  std::size_t exception_count = 0;
+
+  for (std::size_t block = 0; block < packed.block_count(); ++block) {
+    EXPECT_EQ(7, packed.bit_width(block)) << block;
+
+    for (const auto& e : packed.exceptions(block))
+      EXPECT_EQ(values[block * array_type::block_size + e.index], e.value);
+
+    exception_count += packed.exceptions(block).size();
+  }
+
+  EXPECT_EQ(20, exception_count);
+
+  // A single width for all values would need 33 bits, i.e. one value per word
+  EXPECT_EQ(7 * 16 + 13, packed.words().size());
+
+  std::vector<std::int64_t> out(values.size());
+  packed.decode(out);
+
+  EXPECT_EQ(values, out);
+}
+
+TEST(PatchedFrameOfReference, Extremes)
+{
+  using array_type = multipleint::pfor_array<std::uint16_t, 64>;
+
+  constexpr auto highest = std::numeric_limits<std::int64_t>::max();
+  constexpr auto lowest = std::numeric_limits<std::int64_t>::lowest();
+
+  for (const auto& values : {std::vector<std::int64_t> {highest, highest - 7, lowest, highest - 3, 0},
+                             std::vector<std::int64_t> {lowest, lowest + 7, highest, lowest + 1, lowest + 1},
+                             std::vector<std::int64_t> {lowest, highest}})
+  {
+    const auto packed = array_type::encode(values);
+
+    std::vector<std::int64_t> out(values.size());
+    packed.decode(out);
+
+    EXPECT_EQ(values, out);
+    EXPECT_EQ(highest, multipleint::max_red(std::execution::seq, packed));
+    EXPECT_EQ(static_cast<std::int64_t>(std::accumulate(
+                  values.begin(), values.end(), std::uint64_t {0}, [](std::uint64_t sum, std::int64_t v)
+                  { return sum + static_cast<std::uint64_t>(v); })),
+              multipleint::sum_red(std::execution::seq, packed));
+
+    std::vector<std::uint64_t> bitmap(1);
+    multipleint::range_scan(std::execution::seq, packed, lowest, highest, std::span {bitmap});
+    EXPECT_EQ((std::uint64_t {1} << values.size()) - 1, bitmap[0]);
+
+    multipleint::range_scan(std::execution::seq, packed, values[1], values[1], std::span {bitmap});
+    EXPECT_EQ(0b10, bitmap[0] & 0b11);
+  }
+}
+
+template<typename BackingStorage, std::size_t BlockSize>
+static void expect_array_algorithms_match_scalar()
+{
+  using array_type = multipleint::pfor_array<BackingStorage, BlockSize>;
+
+  // Ranges growing from block to block, a few outliers in both directions
+  std::vector<std::int64_t> values(3000);
+
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    const auto range = static_cast<std::int64_t>(1) << ((i / BlockSize) % 24);
+
+    values[i] = -40'000 + static_cast<std::int64_t>((i * 7919) % 1'000'003) % range;
+
+    if (i % 97 == 0)
+      values[i] = (i % 2 == 0) ? -(static_cast<std::int64_t>(i) << 40) : (static_cast<std::int64_t>(i) << 40);
+  }
+
+  const auto packed = array_type::encode(values);
+
+  std::vector<std::int64_t> out(values.size());
+  packed.decode(out);
+
+  ASSERT_EQ(values, out);
+
+  EXPECT_EQ(std::accumulate(values.begin(), values.end(), std::int64_t {0}),
+            multipleint::sum_red(std::execution::par_unseq, packed));
+  EXPECT_EQ(*std::max_element(values.begin(), values.end()), multipleint::max_red(std::execution::par_unseq, packed));
+
+  for (const auto& [lo, hi] : {std::pair<std::int64_t, std::int64_t> {-40'000, -39'990},
+                               std::pair<std::int64_t, std::int64_t> {-39'000, 1'000'000},
+                               std::pair<std::int64_t, std::int64_t> {-40'000, -40'000},
+                               std::pair<std::int64_t, std::int64_t> {0, std::numeric_limits<std::int64_t>::max()}})
+  {
+    std::vector<std::uint64_t> bitmap((values.size() + 63) / 64, ~std::uint64_t {0});
+    multipleint::range_scan(std::execution::par_unseq, packed, lo, hi, std::span {bitmap});
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+      ASSERT_EQ(lo <= values[i] && values[i] <= hi, (bitmap[i / 64] >> (i % 64)) & 1) << i;
+  }
+}
+
+TEST(PatchedFrameOfReference, ArrayAlgorithms)
+{
+  expect_array_algorithms_match_scalar<std::uint64_t, 128>();
+  expect_array_algorithms_match_scalar<std::uint32_t, 192>();
+  expect_array_algorithms_match_scalar<std::uint8_t, 64>();
+}
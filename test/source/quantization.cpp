@@ -0,0 +1,141 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/mialgorithm.hpp>
+#include <multipleint/micpu.hpp>
+#include <multipleint/milimits.hpp>
+
+// Values around and beyond the range of the lanes, exact ties, infinities and NaN
+static auto test_floats(std::size_t n, float scale, int zero_point, int range) -> std::vector<float>
+{
+  std::vector<float> result(n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto k = static_cast<float>(static_cast<int>(i % static_cast<std::size_t>(3 * range)) - range - range / 2);
+
+    switch (i % 5) {
+      case 0: result[i] = (k - static_cast<float>(zero_point)) * scale; break;
+      case 1: result[i] = (k + 0.5f) * scale; break;
+      case 2: result[i] = (k - 0.25f) * scale; break;
+      case 3: result[i] = k * 0.37f * scale; break;
+      default: result[i] = (k + 0.75f) * scale;
+    }
+  }
+
+  result[3] = std::numeric_limits<float>::infinity();
+  result[8] = -std::numeric_limits<float>::infinity();
+  result[13] = std::numeric_limits<float>::quiet_NaN();
+  result[18] = 1e30f;
+
+  return result;
+}
+
+template<std::size_t BitWidth, typename BackingStorage>
+static void expect_quantized(float scale, int zero_point)
+{
+  using T = multipleint::multiple_int<BitWidth, BackingStorage>;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+  const std::int64_t min = std::numeric_limits<T>::min().template extract<0, int>();
+  const std::int64_t max = std::numeric_limits<T>::max().template extract<0, int>();
+
+  // More than one block of the parallel algorithms, a partially filled last word
+  constexpr std::size_t words = 5000;
+  const auto n = words * int_count - 1;
+
+  const auto in = test_floats(n, scale, zero_point, static_cast<int>(std::min<std::int64_t>(max, 1000)));
+
+  // The reference goes through an int array and encode_bulk
+  std::vector<std::int32_t> expected(n);
+
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto q = std::nearbyint(in[i] / scale);
+
+    if (std::isnan(q))
+      expected[i] = static_cast<std::int32_t>(std::clamp<std::int64_t>(zero_point, min, max));
+    else if (std::isinf(q) || std::abs(q) > 1e12f)
+      expected[i] = static_cast<std::int32_t>(q < 0 ? min : max);
+    else
+      expected[i] = static_cast<std::int32_t>(std::clamp(static_cast<std::int64_t>(q) + zero_point, min, max));
+  }
+
+  std::vector<T> reference(words);
+  multipleint::encode_bulk(std::execution::seq, std::span<const std::int32_t> {expected}, std::span {reference});
+
+  std::vector<T> out(words);
+  multipleint::quantize(std::execution::par_unseq, std::span<const float> {in}, scale, zero_point, std::span {out});
+
+  for (std::size_t w = 0; w < words; ++w)
+    ASSERT_EQ(reference[w].template decode<int_count>(), out[w].template decode<int_count>()) << w;
+
+  // Every instruction set the CPU supports
+  using multipleint::isa;
+
+  for (auto target : {isa::scalar, isa::sse42, isa::avx2, isa::avx512}) {
+    if (target > multipleint::best_isa())
+      continue;
+
+    std::vector<T> words_out(words);
+    std::vector<float> floats_out(words * int_count);
+
+    multipleint::detail::_select_kernel<multipleint::detail::_quantize_kernel,
+                                        const float*,
+                                        T*,
+                                        std::size_t,
+                                        float,
+                                        int>(target)(in.data(), words_out.data(), words - 1, scale, zero_point);
+
+    multipleint::detail::_select_kernel<multipleint::detail::_dequantize_kernel,
+                                        const T*,
+                                        float*,
+                                        std::size_t,
+                                        float,
+                                        int>(target)(out.data(), floats_out.data(), words, scale, zero_point);
+
+    for (std::size_t w = 0; w + 1 < words; ++w)
+      ASSERT_EQ(reference[w].template decode<int_count>(), words_out[w].template decode<int_count>()) << w;
+
+    for (std::size_t i = 0; i < n; ++i)
+      ASSERT_EQ(static_cast<float>(expected[i] - zero_point) * scale, floats_out[i]) << i;
+  }
+
+  // The way back
+  std::vector<float> back(n);
+  multipleint::dequantize(std::execution::par_unseq, std::span<const T> {out}, scale, zero_point, std::span {back});
+
+  for (std::size_t i = 0; i < n; ++i)
+    ASSERT_EQ(static_cast<float>(expected[i] - zero_point) * scale, back[i]) << i;
+}
+
+template<std::size_t BitWidth>
+concept quantizable = requires(std::span<multipleint::multiple_int<BitWidth, std::uint64_t>> out) {
+  multipleint::quantize(std::execution::seq, std::span<const float> {}, 1.0f, 0, out);
+};
+
+TEST(Quantization, RoundsAndClamps)
+{
+  // The lanes hold ints
+  static_assert(quantizable<32>);
+  static_assert(!quantizable<33>);
+
+  expect_quantized<7, std::uint64_t>(0.5f, 0);
+  expect_quantized<7, std::uint64_t>(0.03125f, -3);
+  expect_quantized<15, std::uint32_t>(0.001f, 100);
+  expect_quantized<31, std::uint64_t>(0.25f, 7);
+  expect_quantized<5, std::uint64_t>(0.5f, 2);
+  expect_quantized<11, std::uint32_t>(0.1f, -40);
+  expect_quantized<3, std::uint8_t>(1.0f, 0);
+
+  // A zero_point outside the range of the lanes
+  expect_quantized<5, std::uint64_t>(0.5f, 100);
+  expect_quantized<7, std::uint64_t>(2.0f, -1000);
+}
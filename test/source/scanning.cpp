@@ -0,0 +1,54 @@
+#include <cstdint>
+#include <execution>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/mialgorithm.hpp>
+
+TEST(InRange, Bitmask)
+{
+  using target_type = multipleint::multiple_int<7, std::uint64_t>;
+
+  constexpr auto num = target_type::encode<8>({5, -3, 63, 0, -64, -4, 17, -1});
+
+  EXPECT_EQ(0b1000'1011, num.in_range(-3, 5));
+  EXPECT_EQ(0b0000'0000, num.in_range(6, 16));
+  EXPECT_EQ(0b0000'0000, num.in_range(5, -3));
+  EXPECT_EQ(0b0011'0010, num.in_range(-64, -3));
+  EXPECT_EQ(0b0100'0100, num.in_range(17, 63));
+  EXPECT_EQ(0b1111'1111, num.in_range(-1000, 1000));
+}
+
+TEST(InRange, Overflows)
+{
+  using target_type = multipleint::multiple_int<3, std::uint16_t>;
+
+  // -4 - 3 as well as 3 - (-4) overflow in 3 bits
+  constexpr auto num = target_type::encode<4>({-4, 3, 0, -1});
+
+  EXPECT_EQ(0b1100, num.in_range(-1, 0));
+  EXPECT_EQ(0b0010, num.in_range(3, 3));
+  EXPECT_EQ(0b0001, num.in_range(-4, -4));
+  EXPECT_EQ(0b1101, num.in_range(-4, 2));
+}
+
+TEST(RangeScan, Bitmap)
+{
+  // 3 integers per word -> words overlap the bitmap words
+  using m_int = multipleint::multiple_int<16, std::uint64_t>;
+
+  std::vector<m_int> v(1000, m_int::encode<3>({-7, 100, 3}));
+  v[21].encode<1>(4);  // logical index 64
+
+  std::vector<std::uint64_t> bitmap((v.size() * 3 + 63) / 64);
+  multipleint::range_scan(std::execution::par_unseq, v.cbegin(), v.cend(), 0, 10, bitmap);
+
+  // Only the last integer of every word is in range
+  EXPECT_EQ(0x4924'9249'2492'4924, bitmap[0]);
+  EXPECT_EQ(0x2492'4924'9249'2493, bitmap[1]);
+  EXPECT_EQ(0x9249'2492'4924'9249, bitmap[2]);
+
+  // 3000 integers fill 46 bitmap words and 56 bits of the last one
+  EXPECT_EQ(0x0092'4924'9249'2492, bitmap.back());
+}
@@ -0,0 +1,90 @@
+#include <execution>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/mialgorithm.hpp>
+
+TEST(Broadcast, FromValue)
+{
+  using target_type = multipleint::multiple_int<7, std::uint32_t>;
+
+  constexpr auto num = target_type::broadcast(-3);
+
+  EXPECT_EQ((std::array<int, 4> {-3, -3, -3, -3}), num.decode<4>());
+  EXPECT_EQ(0, num.carry());
+}
+
+TEST(FindLane, FirstMatch)
+{
+  using target_type = multipleint::multiple_int<7, std::uint64_t>;
+
+  constexpr auto num = target_type::encode<8>({5, -3, 63, 0, -64, -3, 17, -1});
+
+  EXPECT_EQ(1, num.find_lane(-3));
+  EXPECT_EQ(3, num.find_lane(0));
+  EXPECT_EQ(4, num.find_lane(-64));
+  EXPECT_EQ(7, num.find_lane(-1));
+  EXPECT_EQ(target_type::IntCount, num.find_lane(4));
+}
+
+TEST(Contains, NoFalsePositives)
+{
+  using target_type = multipleint::multiple_int<3, std::uint16_t>;
+
+  // Neighbouring lanes of 0 and -1 must not leak a "zero lane" into each other
+  constexpr auto num = target_type::encode<4>({-1, 0, -1, 1});
+
+  EXPECT_TRUE(num.contains(-1));
+  EXPECT_TRUE(num.contains(0));
+  EXPECT_TRUE(num.contains(1));
+  EXPECT_FALSE(num.contains(2));
+  EXPECT_FALSE(num.contains(-4));
+  EXPECT_EQ(2, num.count(-1));
+}
+
+TEST(Contains, OutOfRange)
+{
+  using target_type = multipleint::multiple_int<7, std::uint64_t>;
+
+  // 200 and -56 have the same lowest 7 bits
+  constexpr auto num = target_type::encode<8>({1, 2, -56, 4, 5, 6, 7, -56});
+
+  static_assert(num.find_lane(200) == target_type::IntCount);
+  static_assert(!num.contains(200));
+  static_assert(num.count(200) == 0);
+  static_assert(num.count(-56) == 2);
+  static_assert(!num.contains(-184));
+  static_assert(!num.contains(64));
+
+  std::vector v(100, num);
+
+  EXPECT_EQ(v.size() * 8, multipleint::find_first(std::execution::par_unseq, v.cbegin(), v.cend(), 200));
+  EXPECT_EQ(0, multipleint::count_equal(std::execution::par_unseq, v.cbegin(), v.cend(), 200));
+  EXPECT_EQ(200, multipleint::count_equal(std::execution::par_unseq, v.cbegin(), v.cend(), -56));
+}
+
+TEST(FindFirst, GlobalIndex)
+{
+  using m_int = multipleint::multiple_int<15, std::uint64_t>;
+
+  std::vector<m_int> v(1000, m_int::encode<4>({1, 2, 3, 4}));
+  v[700].encode<2>(-42);
+  v[900].encode<0>(-42);
+
+  EXPECT_EQ(700 * 4 + 2, multipleint::find_first(std::execution::par_unseq, v.cbegin(), v.cend(), -42));
+  EXPECT_EQ(0, multipleint::find_first(std::execution::par_unseq, v.cbegin(), v.cend(), 1));
+  EXPECT_EQ(3, multipleint::find_first(std::execution::par_unseq, v.cbegin(), v.cend(), 4));
+  EXPECT_EQ(v.size() * 4, multipleint::find_first(std::execution::par_unseq, v.cbegin(), v.cend(), 5));
+}
+
+TEST(CountEqual, AllWords)
+{
+  using m_int = multipleint::multiple_int<7, std::uint32_t>;
+
+  std::vector<m_int> v(1000, m_int::encode<4>({1, 2, 1, 4}));
+  v[10].encode<3>(1);
+
+  EXPECT_EQ(2001, multipleint::count_equal(std::execution::par_unseq, v.cbegin(), v.cend(), 1));
+  EXPECT_EQ(0, multipleint::count_equal(std::execution::par_unseq, v.cbegin(), v.cend(), -1));
+}
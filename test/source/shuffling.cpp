@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+
+TEST(Shuffle, Permutation)
+{
+  using target_type = multipleint::multiple_int<7, std::uint64_t>;
+
+  constexpr auto num = target_type::encode<8>({0, 1, 2, 3, -4, 5, -6, 7});
+  constexpr auto res = num.shuffle<1, 0, 3, 2, 7, 7, 4, 0>();
+  constexpr auto expected = target_type::encode<8>({1, 0, 3, 2, 7, 7, -4, 0});
+
+  EXPECT_EQ(expected.intv(), res.intv()) << "Expected " << std::hex << expected.intv() << ", got " << res.intv()
+                                         << "\n";
+  EXPECT_EQ(0, res.carry());
+}
+
+TEST(Shuffle, CarriesMoveWithValues)
+{
+  using target_type = multipleint::multiple_int<3, std::uint16_t>;
+
+  constexpr auto num = target_type::encode<4>({1, 3, 0, -1});
+  constexpr auto overflown = num + target_type::encode<4>({0, 3, 0, 0});  // 3 + 3 overflows in the 2nd int
+  constexpr auto res = overflown.shuffle<1, 1, 3, 2>();
+
+  EXPECT_EQ(0b0000'0000'1000'1000, res.carry());
+}
+
+TEST(RotateLanes, LikeStdRotate)
+{
+  using target_type = multipleint::multiple_int<2, std::uint16_t>;
+
+  constexpr auto num = target_type::encode<5>({1, -2, 0, -1, 1});
+
+  EXPECT_EQ((std::array<int, 5> {-2, 0, -1, 1, 1}), num.rotate_lanes<1>().decode<5>());
+  EXPECT_EQ((std::array<int, 5> {-1, 1, 1, -2, 0}), num.rotate_lanes<3>().decode<5>());
+  EXPECT_EQ(num.intv(), num.rotate_lanes<0>().intv());
+}
+
+TEST(ReverseLanes, EvenAndOddCount)
+{
+  {
+    using target_type = multipleint::multiple_int<7, std::uint64_t>;
+
+    constexpr auto num = target_type::encode<8>({0, 1, 2, 3, -4, 5, -6, 7});
+
+    EXPECT_EQ((std::array<int, 8> {7, -6, 5, -4, 3, 2, 1, 0}), num.reverse_lanes().decode<8>());
+  }
+
+  {
+    using target_type = multipleint::multiple_int<16, std::uint64_t>;
+
+    constexpr auto num = target_type::encode<3>({-300, 1000, 12});
+
+    EXPECT_EQ((std::array<int, 3> {12, 1000, -300}), num.reverse_lanes().decode<3>());
+  }
+}
+
+TEST(Broadcast, AllLanes)
+{
+  using target_type = multipleint::multiple_int<4, std::uint16_t>;
+
+  constexpr auto num = target_type::encode<3>({3, -8, 7});
+
+  EXPECT_EQ((std::array<int, 3> {3, 3, 3}), num.broadcast<0>().decode<3>());
+  EXPECT_EQ((std::array<int, 3> {-8, -8, -8}), num.broadcast<1>().decode<3>());
+  EXPECT_EQ((std::array<int, 3> {7, 7, 7}), num.broadcast<2>().decode<3>());
+  EXPECT_EQ(0, num.broadcast<1>().carry());
+}
@@ -0,0 +1,74 @@
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+
+TEST(Min, FourInt16Bit)
+{
+  using target_type = multipleint::multiple_int<3, std::uint16_t>;
+
+  constexpr auto l = target_type::encode<4>({0b001, 0b111, 0b110, 0b100});
+  constexpr auto r = target_type::encode<4>({0b001, 0b111, 0b100, 0b101});
+
+  constexpr auto m1 = min(l, r);
+  constexpr auto m2 = min(r, l);
+
+  constexpr auto expected = target_type::encode<4>({0b001, 0b111, 0b100, 0b100});
+
+  EXPECT_EQ(expected.intv(), m1.intv());
+  EXPECT_EQ(expected.intv(), m2.intv());
+}
+
+TEST(SortLanes, EightInt64Bit)
+{
+  using target_type = multipleint::multiple_int<7, std::uint64_t>;
+
+  auto num = target_type::encode<8>({5, -3, 63, 0, -64, 5, 17, -1});
+  num.sort_lanes();
+
+  constexpr auto expected = target_type::encode<8>({-64, -3, -1, 0, 5, 5, 17, 63});
+
+  EXPECT_EQ(expected.intv(), num.intv()) << "Expected " << std::hex << expected.intv() << ", got " << num.intv()
+                                         << "\n";
+  EXPECT_EQ(0, num.carry());
+}
+
+TEST(SortLanes, OddIntCount)
+{
+  using target_type = multipleint::multiple_int<2, std::uint16_t>;
+
+  auto num = target_type::encode<5>({1, -2, 0, -1, 1});
+  num.sort_lanes();
+
+  EXPECT_EQ((std::array<int, 5> {-2, -1, 0, 1, 1}), num.decode<5>());
+}
+
+TEST(SortLanes, CarriesMoveWithValues)
+{
+  using target_type = multipleint::multiple_int<3, std::uint8_t>;
+
+  constexpr auto num = target_type::encode<2>({1, 2});
+  auto overflown = num + target_type::encode<2>({0, 2});  // 2 + 2 overflows in the upper int
+  overflown.sort_lanes();
+
+  // The overflown int wrapped around to -4 and is now the lower int
+  EXPECT_EQ(0b0'001'0'100, overflown.intv());
+  EXPECT_EQ(0b0000'1000, overflown.carry());
+}
+
+TEST(MedianLane, EvenAndOddCount)
+{
+  {
+    using target_type = multipleint::multiple_int<7, std::uint64_t>;
+
+    constexpr auto num = target_type::encode<8>({9, -7, 3, 40, 2, -1, 8, 0});
+
+    EXPECT_EQ(3, num.median_lane());
+  }
+
+  {
+    using target_type = multipleint::multiple_int<16, std::uint64_t>;
+
+    constexpr auto num = target_type::encode<3>({-300, 1000, 12});
+
+    EXPECT_EQ(12, num.median_lane());
+  }
+}
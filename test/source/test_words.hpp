@@ -0,0 +1,43 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <multipleint/mi.hpp>
+#include <multipleint/milimits.hpp>
+
+// Every possible value in every lane, some words with carry bits. Each seed gives another order of the values
+// and another period of the words with carry bits.
+template<class T>
+static auto test_words(std::size_t words, std::size_t seed) -> std::vector<T>
+{
+  // 2 * max + 2 overflows int for 31-bit lanes
+  const std::int64_t limit = std::numeric_limits<T>::max().template extract<0, int>();
+  const auto range = static_cast<std::size_t>(2 * limit + 2);
+
+  std::vector<T> result(words);
+
+  for (std::size_t w = 0; w < words; ++w) {
+    std::array<int, T::IntCount> values {};
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+      values[i] = static_cast<int>(static_cast<std::int64_t>((w * seed + i * 13) % range) - limit - 1);
+
+    result[w] = T::encode(values);
+
+    if (w % (seed + 2) == 0)
+      result[w] = result[w] + std::numeric_limits<T>::max() + std::numeric_limits<T>::max();
+  }
+
+  return result;
+}
+
+// Integer and carry bits of the word
+template<class T>
+static auto raw(T value)
+{
+  return value.intv() | value.carry();
+}
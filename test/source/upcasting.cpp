@@ -1,3 +1,7 @@
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
 #include <gtest/gtest.h>
 #include <multipleint/mi.hpp>
 
@@ -60,3 +64,75 @@ TEST(Upcast, SignBits)
     EXPECT_EQ(0, t.carry());
   }
 }
+
+TEST(Upcast, WidenKeepsLanes)
+{
+  {
+    constexpr auto l = multipleint::multiple_int<3, std::uint8_t>::encode<2>({0b100, 0b011});
+
+    constexpr auto t = multipleint::widen(l);
+
+    static_assert(std::is_same_v<const multipleint::multiple_int<7, std::uint16_t>, decltype(t)>);
+
+    EXPECT_EQ(0b00000'011'01111'100, t.intv());
+    EXPECT_EQ(0, t.carry());
+  }
+
+  {
+    constexpr auto l = multipleint::multiple_int<7, std::uint32_t>::encode<4>({-64, 63, -1, 5});
+
+    constexpr auto t = multipleint::widen(l);
+
+    EXPECT_EQ((std::array {-64, 63, -1, 5}), t.decode<4>());
+    EXPECT_EQ(0, t.carry());
+  }
+
+  {
+    // Carry bits are cleared like by the upcasting constructor
+    using m_int = multipleint::multiple_int<4, std::uint32_t>;
+
+    const auto l = m_int::encode<6>({7, -8, 1, 2, -3, 4}) + m_int::broadcast(1);
+
+    EXPECT_NE(0, l.carry());
+    EXPECT_EQ((std::array {-8, -7, 2, 3, -2, 5}), multipleint::widen(l).decode<6>());
+    EXPECT_EQ(0, multipleint::widen(l).carry());
+  }
+}
+
+TEST(Upcast, UnpackWithinStorage)
+{
+  {
+    using m_int = multipleint::multiple_int<15, std::uint64_t>;
+
+    constexpr auto l = m_int::encode<4>({-16384, 16383, 7, -1});
+
+    constexpr auto lo = multipleint::unpack_lo(l);
+    constexpr auto hi = multipleint::unpack_hi(l);
+
+    static_assert(std::is_same_v<const multipleint::multiple_int<31, std::uint64_t>, decltype(lo)>);
+
+    EXPECT_EQ((std::array {-16384, 16383}), lo.decode<2>());
+    EXPECT_EQ((std::array {7, -1}), hi.decode<2>());
+    EXPECT_EQ(0, lo.carry());
+    EXPECT_EQ(0, hi.carry());
+
+    EXPECT_EQ(l.intv(), multipleint::pack(lo, hi).intv());
+
+    // pack truncates like the downcasting operator, adding 2^15 does not change the lowest 15 bits
+    using wide_int = multipleint::multiple_int<31, std::uint64_t>;
+
+    EXPECT_EQ(l.intv(), multipleint::pack(lo + wide_int::broadcast(1 << 15), hi - wide_int::broadcast(1 << 15)).intv());
+  }
+
+  {
+    // Carry bits are cleared
+    using m_int = multipleint::multiple_int<2, std::uint8_t>;
+
+    const auto l = m_int::encode<2>({1, -2}) + m_int::broadcast(1);
+
+    EXPECT_NE(0, l.carry());
+    EXPECT_EQ((std::array {-2}), multipleint::unpack_lo(l).decode<1>());
+    EXPECT_EQ((std::array {-1}), multipleint::unpack_hi(l).decode<1>());
+    EXPECT_EQ(l.intv(), multipleint::pack(multipleint::unpack_lo(l), multipleint::unpack_hi(l)).intv());
+  }
+}
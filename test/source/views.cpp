@@ -0,0 +1,78 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <sstream>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/miviews.hpp>
+
+namespace views = multipleint::views;
+
+using T = multipleint::multiple_int<7, std::uint64_t>;
+
+template<std::ranges::input_range R>
+static auto to_vector(R&& r)
+{
+  std::vector<std::ranges::range_value_t<R>> result;
+  std::ranges::copy(r, std::back_inserter(result));
+
+  return result;
+}
+
+TEST(Views, Unpacked)
+{
+  const std::vector<T> words {T::encode<8>({1, -2, 3, -4, 5, -6, 7, -8}), T::encode<3>({10, 20, 30})};
+
+  auto ints = words | views::unpacked;
+
+  static_assert(std::ranges::forward_range<decltype(ints)>);
+  static_assert(std::ranges::sized_range<decltype(ints)>);
+
+  EXPECT_EQ(16, ints.size());
+  EXPECT_EQ((std::vector<int> {1, -2, 3, -4, 5, -6, 7, -8, 10, 20, 30, 0, 0, 0, 0, 0}),
+            to_vector(ints));
+
+  // Composes with the standard views
+  std::vector<int> positive;
+  std::ranges::copy(words | views::unpacked | std::views::filter([](int x) { return x > 0; })
+                        | std::views::transform([](int x) { return 2 * x; }),
+                    std::back_inserter(positive));
+
+  EXPECT_EQ((std::vector<int> {2, 6, 10, 14, 20, 40, 60}), positive);
+
+  EXPECT_TRUE(std::ranges::empty(std::vector<T> {} | views::unpacked));
+}
+
+TEST(Views, Packed)
+{
+  const std::vector<int> ints {1, -2, 3, -4, 5, -6, 7, -8, 10, 20, 30};
+
+  auto words = ints | views::packed<7, std::uint64_t>;
+
+  static_assert(std::ranges::forward_range<decltype(words)>);
+
+  EXPECT_EQ(2, words.size());
+
+  const auto packed = to_vector(words);
+  ASSERT_EQ(2, packed.size());
+  EXPECT_EQ((std::array<int, 8> {1, -2, 3, -4, 5, -6, 7, -8}), packed[0].decode<8>());
+  EXPECT_EQ((std::array<int, 8> {10, 20, 30, 0, 0, 0, 0, 0}), packed[1].decode<8>());
+
+  // Round trip of a lazily generated range
+  auto round_trip =
+      std::views::iota(-60, 61) | views::packed<7, std::uint64_t> | views::unpacked | std::views::take(121);
+  EXPECT_TRUE(std::ranges::equal(std::views::iota(-60, 61), round_trip));
+}
+
+TEST(Views, InputRange)
+{
+  // A single-pass source is read word by word as well
+  std::istringstream stream("1 2 3 4 5 6 7 8 9");
+
+  EXPECT_EQ((std::vector<int> {1, 2, 3, 4, 5, 6, 7, 8, 9, 0}),
+            to_vector(std::views::istream<int>(stream) | views::packed<15, std::uint32_t> | views::unpacked));
+}
@@ -0,0 +1,125 @@
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <execution>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <multipleint/mi.hpp>
+#include <multipleint/mialgorithm.hpp>
+#include <multipleint/mibatch.hpp>
+#include <multipleint/mizone.hpp>
+
+// Mostly ascending values with a few words out of order
+template<class T>
+static auto clustered_words(std::size_t words) -> std::vector<T>
+{
+  const auto limit = std::numeric_limits<T>::max().template extract<0, int>();
+
+  const auto range = 2 * static_cast<std::size_t>(limit);
+  const auto count = words * T::IntCount;
+
+  std::vector<T> result(words);
+
+  for (std::size_t w = 0; w < words; ++w) {
+    std::array<int, T::IntCount> values {};
+
+    for (std::size_t i = 0; i < values.size(); ++i)
+      values[i] = -limit + static_cast<int>((w * T::IntCount + i) * range / count);
+
+    if (w % 37 == 5)
+      values[w % values.size()] = limit - static_cast<int>(w % 3);
+
+    result[w] = T::encode(values);
+  }
+
+  return result;
+}
+
+template<std::size_t BitWidth, typename BackingStorage, std::size_t BlockWords>
+static void expect_zoned_algorithms_match()
+{
+  using T = multipleint::multiple_int<BitWidth, BackingStorage>;
+  using array_type = multipleint::zoned_array<BitWidth, BackingStorage, BlockWords>;
+
+  constexpr auto int_count = static_cast<std::size_t>(T::IntCount);
+
+  auto words = clustered_words<T>(1000);
+  array_type x {std::span<const T>(words)};
+
+  // Writes keep the zones up to date
+  const auto limit = std::numeric_limits<T>::max().template extract<0, int>();
+
+  words[500] = T::broadcast(-limit - 1);
+  x.set(500, words[500]);
+
+  words[998] = T::broadcast(0);
+  words[999] = T::broadcast(1);
+  x.assign(998, std::span<const T>(words).subspan(998));
+
+  ASSERT_EQ(words.size(), x.size());
+
+  for (std::size_t block = 0; block < x.block_count(); ++block) {
+    int lowest = std::numeric_limits<int>::max();
+    int highest = std::numeric_limits<int>::lowest();
+
+    for (const auto& word : x.block(block)) {
+      for (auto value : word.template decode<int_count>()) {
+        lowest = std::min(lowest, value);
+        highest = std::max(highest, value);
+      }
+    }
+
+    EXPECT_EQ(lowest, x.zones()[block].min) << block;
+    EXPECT_EQ(highest, x.zones()[block].max) << block;
+  }
+
+  const std::span<const T> view(words);
+
+  for (const auto& init : {std::numeric_limits<T>::lowest(), T::broadcast(limit / 2)}) {
+    const auto expected = multipleint::max_red(std::execution::seq, view, init);
+    const auto actual = multipleint::max_red(std::execution::par_unseq, x, init);
+
+    EXPECT_EQ(expected.template decode<int_count>(), actual.template decode<int_count>());
+  }
+
+  for (int value : {-limit - 1, -limit, 0, 1, limit, limit - 2, limit / 3}) {
+    EXPECT_EQ(multipleint::find_first(std::execution::seq, view.begin(), view.end(), value),
+              multipleint::find_first(std::execution::par_unseq, x, value))
+        << value;
+  }
+
+  for (const auto& [lo, hi] : {std::pair<int, int> {-limit - 1, limit},
+                               std::pair<int, int> {-limit / 2, limit / 4},
+                               std::pair<int, int> {0, 0},
+                               std::pair<int, int> {limit - 1, limit}})
+  {
+    std::vector<std::uint64_t> expected((words.size() * int_count + 63) / 64);
+    std::vector<std::uint64_t> actual(expected.size(), ~std::uint64_t {0});
+
+    multipleint::range_scan(std::execution::seq, view.begin(), view.end(), lo, hi, std::span {expected});
+    multipleint::range_scan(std::execution::par_unseq, x, lo, hi, std::span {actual});
+
+    EXPECT_EQ(expected, actual) << lo << " " << hi;
+  }
+}
+
+TEST(ZoneMap, MatchesUnzoned)
+{
+  expect_zoned_algorithms_match<7, std::uint64_t, 64>();
+  expect_zoned_algorithms_match<5, std::uint32_t, 48>();
+  expect_zoned_algorithms_match<15, std::uint16_t, 1>();
+}
+
+TEST(ZoneMap, Empty)
+{
+  using T = multipleint::multiple_int<7, std::uint64_t>;
+
+  const multipleint::zoned_array<7, std::uint64_t> x;
+
+  EXPECT_EQ(0, multipleint::find_first(std::execution::seq, x, 0));
+  EXPECT_EQ(T::broadcast(3).intv(), multipleint::max_red(std::execution::seq, x, T::broadcast(3)).intv());
+}